@@ -0,0 +1,41 @@
+#ifndef LEXER_BENCHMARKS_INCLUDE_LEXER_BENCHMARKS_CORPUS_HPP
+#define LEXER_BENCHMARKS_INCLUDE_LEXER_BENCHMARKS_CORPUS_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace lexer::benchmarks
+{
+/**
+ * @brief Generators of deterministic inputs, fully tokenizable by the grammar of grammar.hpp.
+ *
+ * Each generator appends whole lines until the requested size is reached, so the result may be slightly longer.
+ */
+class Corpus
+{
+public:
+    /**
+     * @brief Generates C-like source: declarations, assignments, calls and line comments.
+     * @param size The minimum size in bytes.
+     * @return The generated source.
+     */
+    [[nodiscard]] static std::string c_like(std::size_t size);
+
+    /**
+     * @brief Generates a JSON array of flat objects, one member per line.
+     * @param size The minimum size in bytes.
+     * @return The generated document.
+     */
+    [[nodiscard]] static std::string json(std::size_t size);
+
+    /**
+     * @brief Generates service log lines with timestamps, levels and key-value fields.
+     * @param size The minimum size in bytes.
+     * @return The generated log.
+     */
+    [[nodiscard]] static std::string log_lines(std::size_t size);
+};
+
+} // namespace lexer::benchmarks
+
+#endif // LEXER_BENCHMARKS_INCLUDE_LEXER_BENCHMARKS_CORPUS_HPP
@@ -0,0 +1,67 @@
+#ifndef LEXER_BENCHMARKS_INCLUDE_LEXER_BENCHMARKS_GRAMMAR_HPP
+#define LEXER_BENCHMARKS_INCLUDE_LEXER_BENCHMARKS_GRAMMAR_HPP
+
+#include <cstdint>
+
+#include "lexer/core/builder.hpp"
+#include "lexer/core/lexer.hpp"
+#include "lexer/core/options.hpp"
+
+namespace lexer::benchmarks
+{
+/**
+ * @brief Token kinds of the README grammar, extended with the separators needed to tokenize whole sources.
+ */
+enum class Token_kind : std::uint8_t
+{
+    // Keywords
+    Boolean,
+    Char,
+    String,
+    Int8,
+    Uint8,
+    Int16,
+    Uint16,
+    Int32,
+    Uint32,
+    Int64,
+    Uint64,
+
+    // Identifier
+    Identifier,
+
+    // Literals
+    Integer_literal,
+    String_literal,
+    Wide_string_literal,
+    Character_literal,
+    Wide_character_literal,
+    Fixed_point_literal,
+    Floating_point_literal,
+
+    // Comments
+    Single_line_comment,
+    Multi_line_comment,
+
+    // Separators
+    Whitespace,
+    Newline,
+    Punctuation,
+};
+
+/**
+ * @brief Registers the tokens of the README grammar.
+ * @return A builder holding every token definition.
+ */
+[[nodiscard]] core::Builder grammar();
+
+/**
+ * @brief Builds the lexer of the README grammar.
+ * @param options The build options.
+ * @return The lexer.
+ */
+[[nodiscard]] core::Lexer build_lexer(const core::Options& options = {});
+
+} // namespace lexer::benchmarks
+
+#endif // LEXER_BENCHMARKS_INCLUDE_LEXER_BENCHMARKS_GRAMMAR_HPP
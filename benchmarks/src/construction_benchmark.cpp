@@ -0,0 +1,296 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lexer/benchmarks/grammar.hpp"
+#include "lexer/core/builder.hpp"
+#include "lexer/dfa/comb_table.hpp"
+#include "lexer/dfa/default_table.hpp"
+#include "lexer/dfa/narrow_table.hpp"
+#include "lexer/dfa/table.hpp"
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+using namespace lexer;
+using namespace lexer::core;
+using namespace lexer::regex;
+
+namespace
+{
+// Keyword spelled from the base-26 digits of its index, so that keywords share prefixes as in real grammars.
+std::string keyword(std::size_t index)
+{
+    std::string result{"kw_"};
+
+    do
+    {
+        result += static_cast<char>('a' + index % 26);
+        index /= 26;
+    } while (index != 0);
+
+    return result;
+}
+
+// Keywords over an identifier pattern.
+Builder keywords(const std::size_t count)
+{
+    Builder builder;
+
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        builder.add_token(text(keyword(i)), i, 1);
+    }
+
+    builder.add_token(concat(any_of(Set::alpha() + '_'), kleene(any_of(Set::alphanum() + '_'))), count, 2);
+
+    return builder;
+}
+
+// A single token matching any of many keywords, as generated grammars spell operator and keyword classes.
+Builder alternatives(const std::size_t count)
+{
+    std::vector<std::shared_ptr<const Regex>> keywords;
+
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        keywords.push_back(text(keyword(i)));
+    }
+
+    Builder builder;
+
+    builder.add_token(Choice::create(std::move(keywords)), 0, 1);
+
+    return builder;
+}
+
+// Tokens made of a keyword prefix followed by a bounded repetition of digits.
+Builder ranges(const std::size_t count)
+{
+    Builder builder;
+
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        builder.add_token(concat(text(keyword(i)), range(any_of(Set::digits()), 1, 8)), i, 1);
+    }
+
+    return builder;
+}
+
+// Tokens over large, overlapping character sets.
+Builder sets(const std::size_t count)
+{
+    Builder builder;
+
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const auto excluded{static_cast<char>('!' + i % 94)};
+
+        builder.add_token(concat(text(keyword(i)), plus(any_of(Set::printable() - excluded))), i, 1);
+    }
+
+    return builder;
+}
+
+// Protocol-style field list: a bounded repetition of a compound field pattern.
+std::shared_ptr<const Regex> fields(const std::size_t max)
+{
+    const auto digit{any_of(Set::digits())};
+
+    const auto value{choice(plus(digit), concat(text("\""), kleene(none_of(Set::from('"'))), text("\"")))};
+
+    const auto field{concat(any_of(Set::alpha()), kleene(any_of(Set::alphanum())), text("="), value, text(";"))};
+
+    return range(field, 1, max);
+}
+
+// Exposes the intermediate automata to report their sizes.
+class Builder_stats : public Builder
+{
+public:
+    using Builder::dfa;
+    using Builder::nfa;
+};
+
+// Identifier with a length limit, as a bounded repetition of a large character set.
+Builder_stats identifier(const std::size_t max)
+{
+    Builder_stats builder;
+
+    builder.add_token(concat(any_of(Set::alpha() + '_'), range(any_of(Set::alphanum() + '_'), 0, max - 1)), 0, 1);
+
+    return builder;
+}
+
+void build(benchmark::State& state, const Builder& builder, const Options& options = {})
+{
+    Timings timings;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(builder.build(timings, options));
+    }
+
+    const auto report{[&state](const char* name, const Timings::Duration_t duration) {
+        state.counters[name] = benchmark::Counter(
+                std::chrono::duration<double>(duration).count(), benchmark::Counter::kAvgIterations);
+    }};
+
+    report("regex_to_nfa_s", timings.regex_to_nfa);
+    report("merge_s", timings.merge);
+    report("epsilon_closure_s", timings.epsilon_closure);
+    report("subset_construction_s", timings.subset_construction);
+    report("derivatives_s", timings.derivatives);
+    report("minimization_s", timings.minimization);
+    report("pruning_s", timings.pruning);
+    report("table_s", timings.table);
+}
+
+void Build_keywords(benchmark::State& state)
+{
+    build(state, keywords(static_cast<std::size_t>(state.range(0))));
+}
+
+void Build_alternatives(benchmark::State& state)
+{
+    build(state, alternatives(static_cast<std::size_t>(state.range(0))));
+}
+
+void Build_ranges(benchmark::State& state)
+{
+    build(state, ranges(static_cast<std::size_t>(state.range(0))));
+}
+
+void Build_sets(benchmark::State& state)
+{
+    build(state, sets(static_cast<std::size_t>(state.range(0))));
+}
+
+void Lower_bounded_repetition(benchmark::State& state)
+{
+    const auto regex{fields(static_cast<std::size_t>(state.range(0)))};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(regex->to_nfa());
+    }
+}
+
+void Build_bounded_repetition(benchmark::State& state)
+{
+    const auto builder{identifier(static_cast<std::size_t>(state.range(0)))};
+
+    build(state, builder);
+
+    state.counters["nfa_states"] = static_cast<double>(builder.nfa().size());
+    state.counters["dfa_states"] = static_cast<double>(dfa::Table{builder.dfa()}.size());
+}
+
+void Build_readme_grammar(benchmark::State& state)
+{
+    build(state, benchmarks::grammar());
+}
+
+void Build_readme_grammar_glushkov(benchmark::State& state)
+{
+    build(state, benchmarks::grammar(), {.construction = Construction::Glushkov});
+}
+
+void Build_keywords_glushkov(benchmark::State& state)
+{
+    build(state, keywords(static_cast<std::size_t>(state.range(0))), {.construction = Construction::Glushkov});
+}
+
+// Compiles the minimized DFA of a grammar into a table layout, reporting the size of its transition arrays.
+template <typename Table>
+void compile(benchmark::State& state, const Builder_stats& builder)
+{
+    const auto dfa{builder.dfa()};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Table{dfa});
+    }
+
+    const Table table{dfa};
+
+    state.counters["dfa_states"] = static_cast<double>(table.size());
+    state.counters["table_bytes"] = static_cast<double>(table.bytes());
+}
+
+template <typename Table>
+void Compile_keywords(benchmark::State& state)
+{
+    compile<Table>(state, Builder_stats{keywords(static_cast<std::size_t>(state.range(0)))});
+}
+
+template <typename Table>
+void Compile_ranges(benchmark::State& state)
+{
+    compile<Table>(state, Builder_stats{ranges(static_cast<std::size_t>(state.range(0)))});
+}
+
+template <typename Table>
+void Compile_readme_grammar(benchmark::State& state)
+{
+    compile<Table>(state, Builder_stats{benchmarks::grammar()});
+}
+
+void Build_readme_grammar_derivatives(benchmark::State& state)
+{
+    build(state, benchmarks::grammar(), {.construction = Construction::Derivatives});
+}
+
+void Build_keywords_derivatives(benchmark::State& state)
+{
+    build(state, keywords(static_cast<std::size_t>(state.range(0))), {.construction = Construction::Derivatives});
+}
+
+} // namespace
+
+BENCHMARK(Build_keywords)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_alternatives)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_ranges)->RangeMultiplier(4)->Range(16, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_sets)->RangeMultiplier(4)->Range(16, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(Lower_bounded_repetition)->RangeMultiplier(4)->Range(4, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_bounded_repetition)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_readme_grammar)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_readme_grammar_glushkov)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_keywords_glushkov)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_keywords<dfa::Table>)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_keywords<dfa::Narrow_table<std::uint16_t>>)
+        ->RangeMultiplier(4)
+        ->Range(16, 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_keywords<dfa::Comb_table<std::uint16_t>>)
+        ->RangeMultiplier(4)
+        ->Range(16, 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_keywords<dfa::Default_table<std::uint16_t>>)
+        ->RangeMultiplier(4)
+        ->Range(16, 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_ranges<dfa::Table>)->RangeMultiplier(4)->Range(16, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_ranges<dfa::Narrow_table<std::uint32_t>>)
+        ->RangeMultiplier(4)
+        ->Range(16, 256)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_ranges<dfa::Comb_table<std::uint16_t>>)
+        ->RangeMultiplier(4)
+        ->Range(16, 256)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_ranges<dfa::Default_table<std::uint16_t>>)
+        ->RangeMultiplier(4)
+        ->Range(16, 256)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_readme_grammar<dfa::Table>)->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_readme_grammar<dfa::Narrow_table<std::uint16_t>>)->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_readme_grammar<dfa::Comb_table<std::uint16_t>>)->Unit(benchmark::kMillisecond);
+BENCHMARK(Compile_readme_grammar<dfa::Default_table<std::uint16_t>>)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_readme_grammar_derivatives)->Unit(benchmark::kMillisecond);
+BENCHMARK(Build_keywords_derivatives)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
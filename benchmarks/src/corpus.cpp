@@ -0,0 +1,130 @@
+#include "lexer/benchmarks/corpus.hpp"
+
+#include <array>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string_view>
+
+namespace lexer::benchmarks
+{
+namespace
+{
+// Fixed seed, so that every run measures the same input.
+constexpr std::mt19937::result_type seed{42};
+
+class Generator
+{
+public:
+    template <std::size_t N>
+    std::string_view pick(const std::array<std::string_view, N>& words)
+    {
+        return words[std::uniform_int_distribution<std::size_t>{0, N - 1}(engine_)];
+    }
+
+    std::size_t number(const std::size_t max) { return std::uniform_int_distribution<std::size_t>{0, max}(engine_); }
+
+private:
+    std::mt19937 engine_{seed};
+};
+
+constexpr std::array<std::string_view, 10> types{
+        "boolean", "char", "string", "int8", "uint8", "int16", "uint16", "int32", "uint32", "int64"};
+
+constexpr std::array<std::string_view, 12> names{
+        "count", "index", "buffer", "offset", "length", "result",
+        "value", "node", "parent_id", "next", "flags", "item_count"};
+
+constexpr std::array<std::string_view, 6> functions{"compute", "update_state", "read", "write", "flush", "hash"};
+
+constexpr std::array<std::string_view, 4> levels{"DEBUG", "INFO", "WARN", "ERROR"};
+
+constexpr std::array<std::string_view, 5> paths{
+        "/api/v1/items", "/api/v1/users", "/health", "/metrics", "/api/v2/orders"};
+
+} // namespace
+
+std::string Corpus::c_like(const std::size_t size)
+{
+    Generator generator;
+
+    std::ostringstream oss;
+
+    while (static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        switch (generator.number(4))
+        {
+            case 0:
+                oss << generator.pick(types) << ' ' << generator.pick(names) << " = " << generator.number(99999)
+                    << ";\n";
+                break;
+            case 1:
+                oss << "    " << generator.pick(names) << " = " << generator.pick(functions) << '('
+                    << generator.pick(names) << ", " << generator.number(999) << '.' << generator.number(999)
+                    << ");\n";
+                break;
+            case 2:
+                oss << "    if (" << generator.pick(names) << " < " << generator.number(1024) << ") { "
+                    << generator.pick(functions) << '(' << generator.pick(names) << "); }\n";
+                break;
+            case 3:
+                oss << "    string " << generator.pick(names) << " = \"" << generator.pick(names) << ' '
+                    << generator.number(100) << "\";\n";
+                break;
+            default:
+                oss << "    // " << generator.pick(functions) << " the " << generator.pick(names) << " before "
+                    << generator.pick(functions) << '\n';
+                break;
+        }
+    }
+
+    return oss.str();
+}
+
+std::string Corpus::json(const std::size_t size)
+{
+    Generator generator;
+
+    std::ostringstream oss;
+
+    oss << "[\n";
+
+    while (static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "  {\n";
+        oss << "    \"id\": " << generator.number(1000000) << ",\n";
+        oss << "    \"name\": \"" << generator.pick(names) << "\",\n";
+        oss << "    \"score\": " << generator.number(100) << '.' << generator.number(99) << ",\n";
+        oss << "    \"ratio\": " << generator.number(9) << "e-" << generator.number(9) << ",\n";
+        oss << "    \"tags\": [" << generator.number(9) << ", " << generator.number(99) << ", "
+            << generator.number(999) << "]\n";
+        oss << "  },\n";
+    }
+
+    oss << "  {}\n]\n";
+
+    return oss.str();
+}
+
+std::string Corpus::log_lines(const std::size_t size)
+{
+    Generator generator;
+
+    std::ostringstream oss;
+
+    oss << std::setfill('0');
+
+    while (static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "2024-05-" << std::setw(2) << 1 + generator.number(27) << 'T' << std::setw(2) << generator.number(23)
+            << ':' << std::setw(2) << generator.number(59) << ':' << std::setw(2) << generator.number(59) << '.'
+            << std::setw(3) << generator.number(999) << "Z " << generator.pick(levels) << " [worker-"
+            << generator.number(15) << "] request id=" << generator.number(999999) << " path=\""
+            << generator.pick(paths) << "\" status=" << 200 + generator.number(304)
+            << " latency_ms=" << generator.number(999) << '.' << generator.number(9) << '\n';
+    }
+
+    return oss.str();
+}
+
+} // namespace lexer::benchmarks
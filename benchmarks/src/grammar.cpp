@@ -0,0 +1,95 @@
+#include "lexer/benchmarks/grammar.hpp"
+
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+namespace lexer::benchmarks
+{
+using namespace regex;
+
+core::Builder grammar()
+{
+    core::Builder builder;
+
+    builder.add_token(text("boolean"), Token_kind::Boolean, 1);
+    builder.add_token(text("char"), Token_kind::Char, 1);
+    builder.add_token(text("string"), Token_kind::String, 1);
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(text("uint8"), Token_kind::Uint8, 1);
+    builder.add_token(text("int16"), Token_kind::Int16, 1);
+    builder.add_token(text("uint16"), Token_kind::Uint16, 1);
+    builder.add_token(text("int32"), Token_kind::Int32, 1);
+    builder.add_token(text("uint32"), Token_kind::Uint32, 1);
+    builder.add_token(text("int64"), Token_kind::Int64, 1);
+    builder.add_token(text("uint64"), Token_kind::Uint64, 1);
+
+    const auto identifier{concat(any_of(Set::alpha() + '_'), kleene(any_of(Set::alphanum() + '_')))};
+
+    builder.add_token(identifier, Token_kind::Identifier, 4);
+
+    const auto any_digit{any_of(Set::digits())};
+
+    const auto integer_literal{plus(any_digit)};
+
+    // A string ends at the first unescaped quote; a backslash escapes any printable character.
+    const auto escape_sequence{concat(text("\\"), any_of(Set::printable()))};
+
+    const auto string_character{choice(any_of(Set::printable() - '"' - '\\'), escape_sequence)};
+
+    const auto string_literal{concat(text("\""), kleene(string_character), text("\""))};
+
+    const auto wide_string_literal{concat(text("L\""), kleene(string_character), text("\""))};
+
+    const auto character_literal{concat(text("'"), any_of(Set::printable() + Set::escape()), text("'"))};
+
+    const auto wide_character_literal{concat(text("L'"), any_of(Set::printable() + Set::escape()), text("'"))};
+
+    const auto fixed_point_literal{concat(plus(any_digit), text("."), plus(any_digit))};
+
+    const auto sign_part{choice(text("+"), text("-"))};
+
+    const auto exponent_part{concat(choice(text("e"), text("E")), optional(sign_part), plus(any_digit))};
+
+    const auto leading_digits{concat(plus(any_digit), text("."), kleene(any_digit), optional(exponent_part))};
+
+    const auto leading_decimal{concat(text("."), plus(any_digit), optional(exponent_part))};
+
+    const auto forced_exponent{concat(plus(any_digit), exponent_part)};
+
+    const auto floating_point_literal{
+            concat(optional(sign_part), choice(leading_digits, leading_decimal, forced_exponent))};
+
+    builder.add_token(integer_literal, Token_kind::Integer_literal, 2);
+    builder.add_token(string_literal, Token_kind::String_literal, 2);
+    builder.add_token(wide_string_literal, Token_kind::Wide_string_literal, 2);
+    builder.add_token(character_literal, Token_kind::Character_literal, 2);
+    builder.add_token(wide_character_literal, Token_kind::Wide_character_literal, 2);
+    builder.add_token(fixed_point_literal, Token_kind::Fixed_point_literal, 2);
+    builder.add_token(floating_point_literal, Token_kind::Floating_point_literal, 3);
+
+    const auto single_line_comment{
+            concat(text("//"), kleene(any_of(Set::printable() + Set::escape() - Set::newline())))};
+
+    const auto multi_line_comment{concat(text("/*"), kleene(any_of(Set::printable() + Set::escape())), text("*/"))};
+
+    builder.add_token(single_line_comment, Token_kind::Single_line_comment, 0);
+    builder.add_token(multi_line_comment, Token_kind::Multi_line_comment, 0);
+
+    builder.add_token(plus(any_of(Set::whitespace())), Token_kind::Whitespace, 0);
+    builder.add_token(plus(any_of(Set::newline())), Token_kind::Newline, 0);
+    builder.add_token(any_of(Set::from({'{', '}', '[', ']', '(', ')', '<', '>', ';', ':', ',', '.', '=', '+', '-',
+                                        '*', '/', '%', '&', '|', '!', '?', '#'})),
+                      Token_kind::Punctuation, 5);
+
+    return builder;
+}
+
+core::Lexer build_lexer(const core::Options& options)
+{
+    return grammar().build(options);
+}
+
+} // namespace lexer::benchmarks
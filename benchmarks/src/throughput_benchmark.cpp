@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+
+#include "lexer/benchmarks/corpus.hpp"
+#include "lexer/benchmarks/grammar.hpp"
+#include "lexer/tools/tokenizer/tokenizer.hpp"
+
+using namespace lexer;
+using namespace lexer::benchmarks;
+using namespace lexer::tools::tokenizer;
+
+namespace
+{
+using Generator_t = std::string (*)(std::size_t);
+
+void report(benchmark::State& state, const std::size_t bytes, const std::size_t tokens)
+{
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+
+    state.counters["tokens_per_second"] =
+            benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void Tokenizer_next(benchmark::State& state, const Generator_t generate)
+{
+    const auto lexer{build_lexer()};
+
+    const auto input{generate(static_cast<std::size_t>(state.range(0)))};
+
+    Tokenizer tokenizer{lexer, input};
+
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        tokenizer.reset();
+
+        tokens = 0;
+
+        for (auto result{tokenizer.next<Token_kind>()};; result = tokenizer.next<Token_kind>())
+        {
+            if (!result)
+            {
+                state.SkipWithError(result.error().message().c_str());
+                return;
+            }
+
+            if (!*result)
+            {
+                break;
+            }
+
+            benchmark::DoNotOptimize(**result);
+
+            ++tokens;
+        }
+    }
+
+    report(state, input.size(), tokens);
+}
+
+void Lexer_tokenize(
+        benchmark::State& state, const Generator_t generate, const core::Layout layout = core::Layout::Dense)
+{
+    const auto lexer{build_lexer({.layout = layout})};
+
+    const auto input{generate(static_cast<std::size_t>(state.range(0)))};
+
+    const std::string_view view{input};
+
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        tokens = 0;
+
+        for (std::size_t offset{0}; offset < view.size(); ++tokens)
+        {
+            const auto [token, length]{lexer.tokenize<Token_kind>(view.substr(offset))};
+
+            if (!token || length == 0)
+            {
+                state.SkipWithError("Unrecognized character");
+                return;
+            }
+
+            benchmark::DoNotOptimize(token);
+
+            offset += length;
+        }
+    }
+
+    report(state, input.size(), tokens);
+
+    state.counters["table_bytes"] = static_cast<double>(lexer.bytes());
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(Tokenizer_next, c_like, &Corpus::c_like)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Tokenizer_next, json, &Corpus::json)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Tokenizer_next, log_lines, &Corpus::log_lines)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_CAPTURE(Lexer_tokenize, c_like, &Corpus::c_like)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Lexer_tokenize, json, &Corpus::json)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Lexer_tokenize, log_lines, &Corpus::log_lines)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_CAPTURE(Lexer_tokenize, c_like_comb, &Corpus::c_like, core::Layout::Comb)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Lexer_tokenize, json_comb, &Corpus::json, core::Layout::Comb)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Lexer_tokenize, log_lines_comb, &Corpus::log_lines, core::Layout::Comb)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_CAPTURE(Lexer_tokenize, c_like_defaults, &Corpus::c_like, core::Layout::Defaults)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Lexer_tokenize, json_defaults, &Corpus::json, core::Layout::Defaults)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_CAPTURE(Lexer_tokenize, log_lines_defaults, &Corpus::log_lines, core::Layout::Defaults)
+        ->Arg(1 << 16)
+        ->Arg(1 << 20);
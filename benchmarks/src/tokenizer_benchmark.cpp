@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "lexer/core/builder.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+#include "lexer/tools/tokenizer/tokenizer.hpp"
+
+using namespace lexer;
+using namespace lexer::core;
+using namespace lexer::regex;
+using namespace lexer::tools::tokenizer;
+
+namespace
+{
+enum class Kind : std::uint8_t
+{
+    Run,
+    Letter,
+};
+
+// Every token start scans to the end of the input looking for a 'b' that never appears, then falls back to a single
+// 'a', which makes backtracking longest-match quadratic in the input length.
+Lexer quadratic_lexer()
+{
+    Builder builder;
+
+    builder.add_token(concat(kleene(text("a")), text("b")), Kind::Run, 0);
+    builder.add_token(text("a"), Kind::Letter, 1);
+
+    return builder.build();
+}
+
+void tokenize_quadratic(benchmark::State& state, const Tokenizer::Mode mode)
+{
+    const auto lexer{quadratic_lexer()};
+
+    const std::string input(static_cast<std::size_t>(state.range(0)), 'a');
+
+    for (auto _ : state)
+    {
+        Tokenizer tokenizer{lexer, input, mode};
+
+        std::size_t tokens{0};
+
+        for (auto result{tokenizer.next<Kind>()}; result && *result; result = tokenizer.next<Kind>())
+        {
+            ++tokens;
+        }
+
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetComplexityN(state.range(0));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+
+void Tokenizer_quadratic_backtracking(benchmark::State& state)
+{
+    tokenize_quadratic(state, Tokenizer::Mode::Backtracking);
+}
+
+void Tokenizer_quadratic_linear(benchmark::State& state)
+{
+    tokenize_quadratic(state, Tokenizer::Mode::Linear);
+}
+
+} // namespace
+
+BENCHMARK(Tokenizer_quadratic_backtracking)->RangeMultiplier(2)->Range(1 << 8, 1 << 14)->Complexity();
+BENCHMARK(Tokenizer_quadratic_linear)->RangeMultiplier(2)->Range(1 << 8, 1 << 14)->Complexity();
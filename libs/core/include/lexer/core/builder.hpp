@@ -2,10 +2,16 @@
 #define LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_BUILDER_HPP
 
 #include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
 
 #include "lexer/core/lexer.hpp"
+#include "lexer/core/options.hpp"
+#include "lexer/core/timings.hpp"
 #include "lexer/dfa/dfa.hpp"
 #include "lexer/nfa/builder.hpp"
+#include "lexer/regex/interner.hpp"
 #include "lexer/regex/regex.hpp"
 
 namespace lexer::core
@@ -14,6 +20,7 @@ namespace lexer::core
  * @brief Builder class for constructing a Lexer from regex patterns and tokens.
  *
  * Allows incremental registration of tokens with associated regex patterns and priorities, and builds the final Lexer.
+ * Patterns are only converted to automata when the Lexer is built.
  */
 class Builder
 {
@@ -38,11 +45,45 @@ public:
         add_token(regex, {static_cast<std::size_t>(token), priority});
     }
 
+    /**
+     * @brief Registers several tokens at once.
+     *
+     * Each element is destructured as `[regex, token, priority]`, e.g. a `std::tuple` or an aggregate, and registered
+     * as by add_token(). Registration only stores the patterns, and the NFAs of all tokens are merged in time linear
+     * in their total size when the Lexer is built.
+     *
+     * @tparam Range The range type.
+     * @param tokens The tokens to register, in order.
+     * @throws std::runtime_error if a regex pointer is invalid.
+     */
+    template <std::ranges::input_range Range>
+    void add_tokens(Range&& tokens)
+    {
+        if constexpr (std::ranges::sized_range<Range>)
+        {
+            tokens_.reserve(tokens_.size() + std::ranges::size(tokens));
+        }
+
+        for (const auto& [regex, token, priority] : tokens)
+        {
+            add_token(regex, token, priority);
+        }
+    }
+
     /**
      * @brief Builds and returns the constructed Lexer.
+     * @param options Options controlling the DFA construction.
      * @return The constructed Lexer object.
      */
-    [[nodiscard]] Lexer build() const;
+    [[nodiscard]] Lexer build(const Options& options = {}) const;
+
+    /**
+     * @brief Builds and returns the constructed Lexer, measuring the time spent in each phase.
+     * @param timings The timings, to which the duration of each phase is added.
+     * @param options Options controlling the DFA construction.
+     * @return The constructed Lexer object.
+     */
+    [[nodiscard]] Lexer build(Timings& timings, const Options& options = {}) const;
 
 protected:
     /**
@@ -53,11 +94,51 @@ protected:
 
     /**
      * @brief Returns the constructed DFA from the registered tokens.
+     * @param options Options controlling the DFA construction.
      * @return The constructed DFA object.
      */
-    [[nodiscard]] dfa::Dfa dfa() const;
+    [[nodiscard]] dfa::Dfa dfa(const Options& options = {}) const;
+
+    /**
+     * @brief Returns the constructed NFA, measuring the regex conversion and merge phases.
+     * @param timings The timings to add the phase durations to.
+     * @return The constructed NFA object.
+     */
+    [[nodiscard]] nfa::Nfa nfa(Timings& timings) const;
+
+    /**
+     * @brief Returns the ε-free position automaton of the registered tokens, measuring its construction.
+     * @param timings The timings to add the regex conversion duration to.
+     * @return The constructed NFA object.
+     */
+    [[nodiscard]] nfa::Nfa position_automaton(Timings& timings) const;
+
+    /**
+     * @brief Returns the DFA of the registered tokens built from the derivatives of their regexes, measuring it.
+     *
+     * Every DFA state is the set of derivatives of the token regexes by the input read so far, with those matching
+     * nothing dropped. Derivatives are taken once per class of symbols that none of them tells apart, and the state
+     * accepts the highest-priority token whose derivative matches the empty string.
+     *
+     * @param timings The timings to add the construction duration to.
+     * @return The constructed DFA object, not minimized.
+     */
+    [[nodiscard]] dfa::Dfa derivatives(Timings& timings) const;
+
+    /**
+     * @brief Returns the constructed DFA, measuring every construction phase.
+     * @param options Options controlling the DFA construction.
+     * @param timings The timings to add the phase durations to.
+     * @return The constructed DFA object.
+     */
+    [[nodiscard]] dfa::Dfa dfa(const Options& options, Timings& timings) const;
 
 private:
+    /**
+     * @brief Type representing the registered tokens, each with the canonical node of its pattern.
+     */
+    using Tokens_t = std::vector<std::pair<std::shared_ptr<const regex::Regex>, nfa::Token>>;
+
     /**
      * @brief Internal method to register a token with a regex and NFA token.
      * @param regex The regex pattern.
@@ -68,14 +149,27 @@ private:
     /**
      * @brief Converts an NFA to a DFA using subset construction.
      * @param nfa The NFA to convert.
+     * @param timings The timings to add the subset construction and epsilon closure durations to.
      * @return The constructed DFA.
      */
-    [[nodiscard]] static dfa::Dfa subset_construction(const nfa::Nfa& nfa);
+    [[nodiscard]] static dfa::Dfa subset_construction(const nfa::Nfa& nfa, Timings& timings);
+
+    /**
+     * @brief Builds the DFA of tokens from the derivatives of their regexes.
+     * @param tokens The tokens, in registration order.
+     * @return The constructed DFA.
+     */
+    [[nodiscard]] static dfa::Dfa derivative_construction(const Tokens_t& tokens);
+
+    /**
+     * @brief Registered token patterns, in registration order.
+     */
+    Tokens_t tokens_;
 
     /**
-     * @brief Internal NFA builder used to accumulate token patterns.
+     * @brief Canonical nodes of the registered patterns, so that fragments repeated across tokens are shared.
      */
-    nfa::Builder nfa_;
+    regex::Interner interner_;
 };
 
 } // namespace lexer::core
@@ -1,27 +1,39 @@
 #ifndef LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_LEXER_HPP
 #define LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_LEXER_HPP
 
+#include <concepts>
+#include <cstdint>
 #include <optional>
+#include <utility>
+#include <variant>
 
 #include "lexer/common/concepts.hpp"
+#include "lexer/core/options.hpp"
+#include "lexer/dfa/comb_table.hpp"
+#include "lexer/dfa/default_table.hpp"
 #include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/memo.hpp"
+#include "lexer/dfa/narrow_table.hpp"
 #include "lexer/dfa/simulator.hpp"
+#include "lexer/dfa/table.hpp"
 
 namespace lexer::core
 {
 /**
  * @brief The main Lexer class for tokenizing input using a DFA.
  *
- * Provides methods to tokenize input from iterators or containers, returning the matched token and length.
+ * The DFA is compiled once on construction into a transition table of the chosen layout. Provides methods to tokenize
+ * input from iterators or containers, returning the matched token and length.
  */
 class Lexer
 {
 public:
     /**
      * @brief Constructs a Lexer from a DFA.
-     * @param dfa The DFA to use for tokenization.
+     * @param dfa The DFA to compile and use for tokenization.
+     * @param layout The layout of the compiled transition table.
      */
-    explicit Lexer(dfa::Dfa dfa) : dfa_{std::move(dfa)} {}
+    explicit Lexer(const dfa::Dfa& dfa, const Layout layout = Layout::Dense) : table_{compile(dfa, layout)} {}
 
     /**
      * @brief The result type: a pair of the matched token (if any) and the length of the match.
@@ -42,7 +54,48 @@ public:
         requires(std::integral<T> || std::is_enum_v<T>)
     [[nodiscard]] Result_t<T> tokenize(Iterator begin, Iterator end) const
     {
-        const auto [token, offset]{dfa::Simulator::run(dfa_, begin, end)};
+        const auto [token, offset]{std::visit([begin, end](const auto& table) {
+            return dfa::Simulator::run(table, begin, end);
+        }, table_)};
+
+        return {token ? std::optional<T>{static_cast<T>(token->id())} : std::nullopt, offset};
+    }
+
+    /**
+     * @brief Creates an empty memo for linear-time tokenization of an input.
+     *
+     * @param length The length of the input.
+     * @param capacity The largest number of `(state, position)` pairs the memo holds, whatever the length of the input.
+     * @return A memo to pass to every memoized tokenize() call over that input.
+     */
+    [[nodiscard]] dfa::Memo memo(
+            const std::size_t length, const std::size_t capacity = dfa::Memo::default_capacity) const
+    {
+        return dfa::Memo{std::visit([](const auto& table) { return table.size(); }, table_), length, capacity};
+    }
+
+    /**
+     * @brief Tokenizes input from a pair of iterators, memoizing failed scans for linear-time tokenization.
+     *
+     * Yields the same result as the non-memoized overload. Tokenizing a whole input by repeatedly calling this overload
+     * at increasing positions with the same memo takes linear time, even for patterns that would otherwise rescan the
+     * remaining input at every position.
+     *
+     * @tparam T The token type (enum or integral).
+     * @tparam Iterator The input iterator type.
+     * @param begin Iterator to the current position of the input.
+     * @param end Iterator to the end of the input.
+     * @param memo The memo created for the whole input.
+     * @param position The position of `begin` within the whole input.
+     * @return A pair containing the matched token (if any) and the length of the match.
+     */
+    template <typename T, common::concepts::Iterator Iterator>
+        requires(std::integral<T> || std::is_enum_v<T>)
+    [[nodiscard]] Result_t<T> tokenize(Iterator begin, Iterator end, dfa::Memo& memo, const std::size_t position) const
+    {
+        const auto [token, offset]{std::visit([begin, end, &memo, position](const auto& table) {
+            return dfa::Simulator::run(table, begin, end, memo, position);
+        }, table_)};
 
         return {token ? std::optional<T>{static_cast<T>(token->id())} : std::nullopt, offset};
     }
@@ -61,11 +114,102 @@ public:
         return tokenize<T>(std::begin(container), std::end(container));
     }
 
+    /**
+     * @brief Returns the size of the compiled transition table.
+     * @return The number of bytes taken by the transition arrays.
+     */
+    [[nodiscard]] std::size_t bytes() const
+    {
+        return std::visit([](const auto& table) { return table.bytes(); }, table_);
+    }
+
 private:
     /**
-     * @brief The DFA used for tokenization.
+     * @brief Type representing the compiled DFA, in any of the supported layouts.
+     */
+    using Table_t = std::variant<dfa::Narrow_table<std::uint8_t>,
+            dfa::Narrow_table<std::uint16_t>,
+            dfa::Narrow_table<std::uint32_t>,
+            dfa::Table,
+            dfa::Comb_table<std::uint8_t>,
+            dfa::Comb_table<std::uint16_t>,
+            dfa::Comb_table<std::uint32_t>,
+            dfa::Comb_table<>,
+            dfa::Default_table<std::uint8_t>,
+            dfa::Default_table<std::uint16_t>,
+            dfa::Default_table<std::uint32_t>,
+            dfa::Default_table<>>;
+
+    /**
+     * @brief Compiles a DFA into the transition table of a layout.
+     * @param dfa The DFA to compile.
+     * @param layout The layout of the transition table.
+     * @return The compiled DFA.
+     */
+    [[nodiscard]] static Table_t compile(const dfa::Dfa& dfa, const Layout layout)
+    {
+        if (layout == Layout::Comb)
+        {
+            return narrowest(dfa::Comb_table<>{dfa});
+        }
+
+        if (layout == Layout::Defaults)
+        {
+            return narrowest(dfa::Default_table<>{dfa});
+        }
+
+        // The dense layout takes the narrowest state identifiers that fit the DFA.
+        dfa::Table table{dfa};
+
+        if (dfa::Narrow_table<std::uint8_t>::fits(table))
+        {
+            return Table_t{std::in_place_type<dfa::Narrow_table<std::uint8_t>>, table};
+        }
+
+        if (dfa::Narrow_table<std::uint16_t>::fits(table))
+        {
+            return Table_t{std::in_place_type<dfa::Narrow_table<std::uint16_t>>, table};
+        }
+
+        if (dfa::Narrow_table<std::uint32_t>::fits(table))
+        {
+            return Table_t{std::in_place_type<dfa::Narrow_table<std::uint32_t>>, table};
+        }
+
+        return Table_t{std::in_place_type<dfa::Table>, std::move(table)};
+    }
+
+    /**
+     * @brief Narrows a compiled DFA with wide entries to the narrowest entries that fit.
+     * @tparam Layout_t The template of the table layout, over the type of its entries.
+     * @param table The compiled DFA with wide entries.
+     * @return The compiled DFA.
+     */
+    template <template <std::unsigned_integral> typename Layout_t>
+    [[nodiscard]] static Table_t narrowest(Layout_t<dfa::Dfa::State_t> table)
+    {
+        if (Layout_t<std::uint8_t>::fits(table))
+        {
+            return Table_t{std::in_place_type<Layout_t<std::uint8_t>>, table};
+        }
+
+        if (Layout_t<std::uint16_t>::fits(table))
+        {
+            return Table_t{std::in_place_type<Layout_t<std::uint16_t>>, table};
+        }
+
+        if (Layout_t<std::uint32_t>::fits(table))
+        {
+            return Table_t{std::in_place_type<Layout_t<std::uint32_t>>, table};
+        }
+
+        return Table_t{std::in_place_type<Layout_t<dfa::Dfa::State_t>>, std::move(table)};
+    }
+
+    /**
+     * @brief The compiled DFA used for tokenization.
      */
-    dfa::Dfa dfa_;
+    Table_t table_;
 };
 
 } // namespace lexer::core
@@ -0,0 +1,66 @@
+#ifndef LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_OPTIONS_HPP
+#define LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_OPTIONS_HPP
+
+namespace lexer::core
+{
+/**
+ * @brief Constructions turning the token regexes into a DFA.
+ */
+enum class Construction
+{
+    // Thompson's construction, wiring the NFA of every regex node to its operands with ε transitions.
+    Thompson,
+
+    // Glushkov's construction, with one state per symbol position and no ε transition.
+    Glushkov,
+
+    // Brzozowski's construction, deriving the DFA directly from the regexes without building an NFA.
+    Derivatives,
+};
+
+/**
+ * @brief Layouts of the transition table compiled from the DFA of a Lexer.
+ */
+enum class Layout
+{
+    // Dense `state × class` array, with an entry for every missing transition, in the narrowest state type that fits.
+    Dense,
+
+    // Rows overlapped by row displacement into comb vectors, storing only the present transitions.
+    Comb,
+
+    // Comb vectors storing only the transitions each state does not share with its default state (D²FA).
+    Defaults,
+};
+
+/**
+ * @brief Options controlling how a Builder constructs and compiles the DFA of a Lexer.
+ */
+struct Options
+{
+    /**
+     * @brief The construction of the DFA from the token regexes.
+     */
+    Construction construction{Construction::Thompson};
+
+    /**
+     * @brief Whether the constructed DFA is minimized before it is compiled, instead of only pruning the states that
+     * cannot contribute to a match.
+     */
+    bool minimize{true};
+
+    /**
+     * @brief Whether the epsilon closure of every NFA state is computed once before the subset construction, instead of
+     * walking the epsilon transitions of every reached subset.
+     */
+    bool precompute_closures{true};
+
+    /**
+     * @brief The layout of the compiled transition table.
+     */
+    Layout layout{Layout::Dense};
+};
+
+} // namespace lexer::core
+
+#endif // LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_OPTIONS_HPP
@@ -0,0 +1,71 @@
+#ifndef LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_TIMINGS_HPP
+#define LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_TIMINGS_HPP
+
+#include <chrono>
+
+namespace lexer::core
+{
+/**
+ * @brief Wall-clock time spent in each phase of Builder::build.
+ */
+struct Timings
+{
+    /**
+     * @brief Type representing the duration of a phase.
+     */
+    using Duration_t = std::chrono::nanoseconds;
+
+    /**
+     * @brief Conversion of every registered regex to an NFA.
+     */
+    Duration_t regex_to_nfa{};
+
+    /**
+     * @brief Merging of the per-token NFAs into a single NFA.
+     */
+    Duration_t merge{};
+
+    /**
+     * @brief Epsilon closures, precomputed per state or computed during the subset construction.
+     */
+    Duration_t epsilon_closure{};
+
+    /**
+     * @brief Subset construction, excluding the epsilon closures.
+     */
+    Duration_t subset_construction{};
+
+    /**
+     * @brief Construction of the DFA by derivatives of the regexes, zero unless selected.
+     */
+    Duration_t derivatives{};
+
+    /**
+     * @brief DFA minimization, zero when disabled.
+     */
+    Duration_t minimization{};
+
+    /**
+     * @brief Removal of the unreachable and unproductive states of an unminimized DFA, zero when minimizing.
+     */
+    Duration_t pruning{};
+
+    /**
+     * @brief Compilation of the DFA into the runtime transition table.
+     */
+    Duration_t table{};
+
+    /**
+     * @brief Returns the time spent in all phases.
+     * @return The sum of all phase durations.
+     */
+    [[nodiscard]] Duration_t total() const noexcept
+    {
+        return regex_to_nfa + merge + epsilon_closure + subset_construction + derivatives + minimization + pruning +
+               table;
+    }
+};
+
+} // namespace lexer::core
+
+#endif // LEXER_LIBS_CORE_INCLUDE_LEXER_CORE_TIMINGS_HPP
@@ -1,105 +1,464 @@
 #include "lexer/core/builder.hpp"
 
 #include <algorithm>
+#include <array>
 #include <boost/container_hash/hash.hpp>
-#include <numeric>
+#include <chrono>
+#include <iterator>
+#include <optional>
 #include <queue>
 #include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/minimize.hpp"
+#include "lexer/dfa/prune.hpp"
+#include "lexer/regex/cache.hpp"
+#include "lexer/regex/derivatives.hpp"
+#include "lexer/regex/position_automaton.hpp"
 
 namespace
 {
-struct Hash
+using Clock = std::chrono::steady_clock;
+
+template <typename Function>
+auto timed(lexer::core::Timings::Duration_t& duration, Function&& function)
+{
+    const auto start{Clock::now()};
+
+    const auto stop{[&duration, start] {
+        duration += std::chrono::duration_cast<lexer::core::Timings::Duration_t>(Clock::now() - start);
+    }};
+
+    if constexpr (std::is_void_v<std::invoke_result_t<Function>>)
+    {
+        std::forward<Function>(function)();
+
+        stop();
+    }
+    else
+    {
+        auto result{std::forward<Function>(function)()};
+
+        stop();
+
+        return result;
+    }
+}
+
+// Minimizes the constructed DFA, or else only prunes the states that cannot contribute to a match.
+lexer::dfa::Dfa reduce(const lexer::dfa::Dfa& dfa, const lexer::core::Options& options, lexer::core::Timings& timings)
 {
-    std::size_t operator()(const lexer::nfa::Nfa::States_t& states) const noexcept
+    if (options.minimize)
     {
-        const auto hash{[](auto seed, const auto element) { return boost::hash_combine(seed, element), seed; }};
+        return timed(timings.minimization, [&dfa] { return lexer::dfa::minimize(dfa); });
+    }
+
+    return timed(timings.pruning, [&dfa] { return lexer::dfa::prune(dfa); });
+}
+
+// A derivative state maps the index of every token still matching to the derivative of its regex.
+using Derivative_state = std::vector<std::pair<std::size_t, std::shared_ptr<const lexer::regex::Regex>>>;
+
+// Hashes a derivative state by its canonical derivatives, which are interned and thus compared by address.
+struct Derivative_state_hash
+{
+    std::size_t operator()(const Derivative_state& state) const noexcept
+    {
+        std::size_t seed{0};
+
+        std::ranges::for_each(state, [&seed](const auto& term) {
+            boost::hash_combine(seed, term.first);
+            boost::hash_combine(seed, term.second.get());
+        });
 
-        return std::accumulate(states.cbegin(), states.cend(), static_cast<std::size_t>(0), hash);
+        return seed;
     }
 };
 
-auto build_symbol_table(const lexer::nfa::Nfa& nfa)
+// The target of every symbol from a DFA state, if any.
+using Targets = std::array<std::optional<lexer::dfa::Dfa::State_t>, lexer::regex::Symbols::capacity>;
+
+// Adds the transitions of a DFA state over the runs of symbols with the same target, as classes need not be contiguous.
+void add_transitions(lexer::dfa::Builder& dfa, const lexer::dfa::Dfa::State_t from, const Targets& targets)
 {
-    std::unordered_map<size_t, std::unordered_set<lexer::nfa::Label::Symbol_t>> result;
+    for (std::size_t first{0}; first < targets.size();)
+    {
+        auto last{first};
 
-    const auto filter{[](const auto& pair) { return pair.second.is_symbol(); }};
+        while (last + 1 < targets.size() && targets[last + 1] == targets[first])
+        {
+            ++last;
+        }
 
-    auto view{nfa.transitions() | std::views::keys | std::views::filter(filter)};
+        if (targets[first])
+        {
+            const lexer::dfa::Label label{static_cast<lexer::dfa::Label::Symbol_t>(first),
+                    static_cast<lexer::dfa::Label::Symbol_t>(last)};
 
-    std::ranges::for_each(view, [&result](const auto& pair) { result[pair.first].insert(pair.second.symbol()); });
+            dfa.add_transition(from, label, *targets[first]);
+        }
 
-    return result;
+        first = last + 1;
+    }
 }
 
 } // namespace
 
 namespace lexer::core
 {
-Lexer Builder::build() const
+Lexer Builder::build(const Options& options) const
 {
-    return Lexer{dfa()};
+    Timings timings;
+
+    return build(timings, options);
+}
+
+Lexer Builder::build(Timings& timings, const Options& options) const
+{
+    const auto dfa{this->dfa(options, timings)};
+
+    return timed(timings.table, [&dfa, &options] { return Lexer{dfa, options.layout}; });
 }
 
 nfa::Nfa Builder::nfa() const
 {
-    return nfa_.build();
+    Timings timings;
+
+    return nfa(timings);
 }
 
-dfa::Dfa Builder::dfa() const
+dfa::Dfa Builder::dfa(const Options& options) const
 {
-    return subset_construction(nfa());
+    Timings timings;
+
+    return dfa(options, timings);
 }
 
 void Builder::add_token(const std::shared_ptr<const regex::Regex>& regex, const nfa::Token& token)
 {
-    nfa_ = nfa_.merge(regex->to_nfa().set_accept_token(token));
+    // Patterns are normalized once on registration, so every build lowers the simplified tree, and interned so that
+    // fragments repeated across tokens are lowered once.
+    tokens_.emplace_back(interner_.intern(regex::simplify(regex)), token);
+}
+
+nfa::Nfa Builder::nfa(Timings& timings) const
+{
+    nfa::Builder result;
+
+    // Sub-patterns shared between tokens are lowered once for the whole build.
+    regex::Cache cache;
+
+    for (const auto& [regex, token] : tokens_)
+    {
+        auto nfa{timed(timings.regex_to_nfa, [&regex, &token, &cache] {
+            return regex->to_nfa(cache).set_accept_token(token);
+        })};
+
+        result = timed(timings.merge, [&result, &nfa] { return std::move(result).merge(std::move(nfa)); });
+    }
+
+    return result.build();
+}
+
+nfa::Nfa Builder::position_automaton(Timings& timings) const
+{
+    return timed(timings.regex_to_nfa, [this] {
+        // Tokens share the initial state, which enters the first positions of every regex.
+        regex::Position_automaton automaton;
+
+        for (const auto& [regex, token] : tokens_)
+        {
+            const auto positions{automaton.add(*regex)};
+
+            automaton.start(positions);
+            automaton.accept(positions, token);
+        }
+
+        return automaton.builder().build();
+    });
+}
+
+dfa::Dfa Builder::derivatives(Timings& timings) const
+{
+    return timed(timings.derivatives, [this] { return derivative_construction(tokens_); });
 }
 
-dfa::Dfa Builder::subset_construction(const nfa::Nfa& nfa)
+dfa::Dfa Builder::dfa(const Options& options, Timings& timings) const
 {
+    if (options.construction == Construction::Derivatives)
+    {
+        auto dfa{derivatives(timings)};
+
+        return reduce(dfa, options, timings);
+    }
+
+    auto nfa{options.construction == Construction::Glushkov ? position_automaton(timings) : this->nfa(timings)};
+
+    if (options.precompute_closures)
+    {
+        timed(timings.epsilon_closure, [&nfa] { nfa.precompute_closures(); });
+    }
+
+    auto dfa{subset_construction(nfa, timings)};
+
+    return reduce(dfa, options, timings);
+}
+
+dfa::Dfa Builder::subset_construction(const nfa::Nfa& nfa, Timings& timings)
+{
+    const auto start{Clock::now()};
+
+    const auto epsilon_closure_start{timings.epsilon_closure};
+
     dfa::Builder dfa;
 
-    const auto symbol_table{build_symbol_table(nfa)};
+    // Every closure marks the reached states in the same buffer, which it leaves cleared.
+    std::vector<bool> marked(nfa.size());
+
+    const auto closure{[&nfa, &timings, &marked](const auto& states, auto& result) {
+        timed(timings.epsilon_closure, [&nfa, &states, &marked, &result] {
+            nfa::Nfa::epsilon_closure(nfa, states, marked, result);
+        });
+    }};
+
+    // Each subset is stored once, as the key interning it to its DFA state; the queue refers to the interned keys.
+    // Candidate subsets are looked up as spans, so only new subsets are copied into a key.
+    std::unordered_map<nfa::State_set, dfa::Dfa::State_t, nfa::State_set::Hash, nfa::State_set::Equal> nfa_dfa_map;
+
+    std::queue<std::pair<const nfa::State_set*, dfa::Dfa::State_t>> nfa_queue;
+
+    std::vector<nfa::Nfa::State_t> targets{nfa.init_state()};
 
-    const auto initial_states{nfa::Nfa::epsilon_closure(nfa, {nfa.init_state()})};
+    std::vector<nfa::Nfa::State_t> subset;
 
-    std::unordered_map<nfa::Nfa::States_t, dfa::Dfa::State_t, Hash> nfa_dfa_map{{initial_states, dfa.init_state()}};
+    closure(targets, subset);
 
-    std::queue<nfa::Nfa::States_t> nfa_queue{{initial_states}};
+    const auto& initial_states{nfa_dfa_map.emplace(nfa::State_set{subset}, dfa.init_state()).first->first};
+
+    nfa_queue.emplace(&initial_states, dfa.init_state());
+
+    std::vector<nfa::Nfa::Edge> moves;
+
+    std::vector<nfa::Nfa::Edge> active;
+
+    std::vector<unsigned> boundaries;
 
     while (!nfa_queue.empty())
     {
-        const auto nfa_states{nfa_queue.front()};
+        const auto [nfa_states, dfa_state]{nfa_queue.front()};
 
         nfa_queue.pop();
 
-        const auto dfa_state{nfa_dfa_map.at(nfa_states)};
-
-        if (const auto token = nfa::Nfa::has_accept_token(nfa, nfa_states); token)
+        if (const auto token = nfa::Nfa::has_accept_token(nfa, *nfa_states); token)
         {
             dfa.add_accept_state(dfa_state, dfa::Token{token->id()});
         }
 
-        const auto filter{[&symbol_table](const auto state) { return symbol_table.contains(state); }};
+        // Gather the range edges of the subset, ordered by their first symbol.
+        moves.clear();
+
+        std::ranges::for_each(*nfa_states, [&nfa, &moves](const auto state) {
+            std::ranges::copy(nfa.edges(state), std::back_inserter(moves));
+        });
+
+        std::ranges::sort(moves, {}, &nfa::Nfa::Edge::first);
+
+        // The bounds of all ranges cut the alphabet into disjoint intervals, over each of which the same edges apply.
+        boundaries.clear();
+
+        std::ranges::for_each(moves, [&boundaries](const auto& edge) {
+            boundaries.push_back(edge.first);
+            boundaries.push_back(edge.last + 1u);
+        });
+
+        std::ranges::sort(boundaries);
+
+        boundaries.erase(std::ranges::unique(boundaries).begin(), boundaries.end());
+
+        // Sweep the intervals keeping the edges covering the current one, and merge neighbouring intervals leading to
+        // the same DFA state into a single range transition.
+        active.clear();
+
+        auto next{moves.begin()};
+
+        std::optional<std::tuple<unsigned, unsigned, dfa::Dfa::State_t>> run;
+
+        const auto flush{[&dfa, &run, dfa_state] {
+            if (run)
+            {
+                const auto [first, last, to]{*run};
+
+                dfa.add_transition(
+                        dfa_state,
+                        dfa::Label{static_cast<dfa::Label::Symbol_t>(first), static_cast<dfa::Label::Symbol_t>(last)},
+                        to);
+            }
+        }};
+
+        for (std::size_t i{0}; i + 1 < boundaries.size(); ++i)
+        {
+            const auto first{boundaries[i]};
+
+            const auto last{boundaries[i + 1] - 1};
+
+            std::erase_if(active, [first](const auto& edge) { return edge.last < first; });
+
+            for (; next != moves.end() && next->first == first; ++next)
+            {
+                active.push_back(*next);
+            }
+
+            if (active.empty())
+            {
+                continue;
+            }
+
+            targets.clear();
+
+            std::ranges::transform(active, std::back_inserter(targets), [](const auto& edge) { return edge.to; });
+
+            closure(targets, subset);
+
+            auto iterator{nfa_dfa_map.find(std::span<const nfa::Nfa::State_t>{subset})};
+
+            if (iterator == nfa_dfa_map.end())
+            {
+                iterator = nfa_dfa_map.emplace(nfa::State_set{subset}, dfa.next_state()).first;
+
+                nfa_queue.emplace(&iterator->first, iterator->second);
+            }
+
+            if (run && std::get<1>(*run) + 1 == first && std::get<2>(*run) == iterator->second)
+            {
+                std::get<1>(*run) = last;
+            }
+            else
+            {
+                flush();
+
+                run.emplace(first, last, iterator->second);
+            }
+        }
+
+        flush();
+    }
+
+    auto result{dfa.build()};
+
+    const auto elapsed{std::chrono::duration_cast<Timings::Duration_t>(Clock::now() - start)};
+
+    timings.subset_construction += elapsed - (timings.epsilon_closure - epsilon_closure_start);
+
+    return result;
+}
+
+dfa::Dfa Builder::derivative_construction(const Tokens_t& tokens)
+{
+    regex::Derivatives derivatives;
+
+    Derivative_state initial_state;
+
+    for (std::size_t i{0}; i < tokens.size(); ++i)
+    {
+        if (auto regex{derivatives.intern(tokens[i].first)}; regex != derivatives.empty())
+        {
+            initial_state.emplace_back(i, std::move(regex));
+        }
+    }
+
+    dfa::Builder dfa;
+
+    // Each state is stored once, as the key interning it to its DFA state; the queue refers to the interned keys.
+    std::unordered_map<Derivative_state, dfa::Dfa::State_t, Derivative_state_hash> states;
 
-        const auto transform{[&symbol_table](const auto state) { return symbol_table.at(state); }};
+    std::queue<std::pair<const Derivative_state*, dfa::Dfa::State_t>> queue;
 
-        auto view{nfa_states | std::views::filter(filter) | std::views::transform(transform) | std::views::join};
+    queue.emplace(&states.emplace(std::move(initial_state), dfa.init_state()).first->first, dfa.init_state());
 
-        std::ranges::for_each(view, [&](const auto symbol) {
-            const auto next_states{nfa::Nfa::advance(nfa, nfa_states, symbol)};
+    Targets targets;
 
-            if (!next_states.empty() && nfa_dfa_map.emplace(next_states, dfa.next_state()).second)
+    while (!queue.empty())
+    {
+        const auto [state, dfa_state]{queue.front()};
+
+        queue.pop();
+
+        std::optional<nfa::Token> token;
+
+        for (const auto& [index, regex] : *state)
+        {
+            if (derivatives.nullable(*regex) && (!token || tokens[index].second < *token))
             {
-                nfa_queue.push(next_states);
+                token = tokens[index].second;
             }
+        }
+
+        if (token)
+        {
+            dfa.add_accept_state(dfa_state, dfa::Token{token->id()});
+        }
+
+        // No term tells apart the symbols of a class, so every class leads to a single state.
+        regex::Derivatives::Classes_t classes{~regex::Symbols{}};
 
-            dfa.add_transition(dfa_state, dfa::Label{symbol}, nfa_dfa_map.at(next_states));
+        std::ranges::for_each(*state, [&derivatives, &classes](const auto& term) {
+            classes = regex::Derivatives::meet(classes, derivatives.classes(*term.second));
         });
+
+        // Each term is derived once per class of its own, which covers the classes of the state refining it.
+        std::vector<Derivative_state> next_states(classes.size());
+
+        for (const auto& [index, regex] : *state)
+        {
+            for (const auto& symbols : derivatives.classes(*regex))
+            {
+                const auto derivative{derivatives.derive(regex, *symbols.begin())};
+
+                if (derivative == derivatives.empty())
+                {
+                    continue;
+                }
+
+                for (std::size_t i{0}; i < classes.size(); ++i)
+                {
+                    if (auto common{classes[i]}; !(common &= symbols).empty())
+                    {
+                        next_states[i].emplace_back(index, derivative);
+                    }
+                }
+            }
+        }
+
+        targets.fill(std::nullopt);
+
+        for (std::size_t i{0}; i < classes.size(); ++i)
+        {
+            if (next_states[i].empty())
+            {
+                continue;
+            }
+
+            auto [iterator, inserted]{states.try_emplace(std::move(next_states[i]), 0)};
+
+            if (inserted)
+            {
+                iterator->second = dfa.next_state();
+
+                queue.emplace(&iterator->first, iterator->second);
+            }
+
+            std::ranges::for_each(classes[i], [&targets, iterator](const auto symbol) {
+                targets[symbol] = iterator->second;
+            });
+        }
+
+        add_transitions(dfa, dfa_state, targets);
     }
 
     return dfa.build();
@@ -2,8 +2,11 @@
 
 #include <filesystem>
 #include <fstream>
+#include <tuple>
+#include <vector>
 
 #include "lexer/core/builder.hpp"
+#include "lexer/dfa/table.hpp"
 #include "lexer/dfa/tools/graphviz.hpp"
 #include "lexer/nfa/tools/graphviz.hpp"
 #include "lexer/regex/any_of.hpp"
@@ -24,10 +27,25 @@ namespace
 class Builder_dbg : public Builder
 {
 public:
+    using Builder::derivatives;
     using Builder::dfa;
     using Builder::nfa;
+    using Builder::position_automaton;
 };
 
+// Counts the transitions of a DFA over the edges of all its states.
+std::size_t edge_count(const dfa::Dfa& automaton)
+{
+    std::size_t count{0};
+
+    for (dfa::Dfa::State_t state{0}; state < automaton.size(); ++state)
+    {
+        count += automaton.edges(state).size();
+    }
+
+    return count;
+}
+
 } // namespace
 
 class Lexer_test : public testing::Test
@@ -579,3 +597,438 @@ TEST_F(Lexer_test, Test_combined)
     EXPECT_EQ(lexer.tokenize<Token_kind>("// a comment"), Result_t(Token_kind::Single_line_comment, 12));
     EXPECT_EQ(lexer.tokenize<Token_kind>("/* a comment */"), Result_t(Token_kind::Multi_line_comment, 15));
 }
+
+TEST_F(Lexer_test, Test_minimize)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Int16,
+        Uint8,
+        Uint16,
+        Identifier,
+    };
+
+    Builder_dbg builder;
+
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(text("int16"), Token_kind::Int16, 1);
+    builder.add_token(text("uint8"), Token_kind::Uint8, 1);
+    builder.add_token(text("uint16"), Token_kind::Uint16, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+
+    const auto minimized{builder.dfa()};
+    const auto unminimized{builder.dfa({.minimize = false})};
+
+    EXPECT_LT(dfa::Table{minimized}.size(), dfa::Table{unminimized}.size());
+
+    const auto lexer{builder.build()};
+    const auto unminimized_lexer{builder.build({.minimize = false})};
+
+    for (const std::string input : {"int8", "int16", "uint8", "uint16", "int", "uint1", "int8x", "_u8", "9"})
+    {
+        EXPECT_EQ(lexer.tokenize<Token_kind>(input), unminimized_lexer.tokenize<Token_kind>(input)) << input;
+    }
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    EXPECT_EQ(lexer.tokenize<Token_kind>("uint16"), Result_t(Token_kind::Uint16, 6));
+    EXPECT_EQ(lexer.tokenize<Token_kind>("uint"), Result_t(Token_kind::Identifier, 4));
+}
+
+TEST_F(Lexer_test, Test_prune)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Never,
+    };
+
+    Builder_dbg builder;
+
+    // The second token can never complete, so once past '#' no token can be accepted.
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(concat(text("#"), kleene(any_of(Set::alpha())), any_of(Set{})), Token_kind::Never, 1);
+
+    // Only the initial state and the states of "int8" remain.
+    EXPECT_EQ(dfa::Table{builder.dfa({.minimize = false})}.size(), 5);
+
+    const auto lexer{builder.build({.minimize = false})};
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    EXPECT_EQ(lexer.tokenize<Token_kind>("int8"), Result_t(Token_kind::Int8, 4));
+    EXPECT_EQ(lexer.tokenize<Token_kind>("#abc"), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Lexer_test, Test_memo)
+{
+    enum class Token_kind : uint8_t
+    {
+        Run,
+        Letter,
+    };
+
+    Builder builder;
+
+    builder.add_token(concat(kleene(text("a")), text("b")), Token_kind::Run, 0);
+    builder.add_token(text("a"), Token_kind::Letter, 1);
+
+    const auto lexer{builder.build()};
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    const std::string input{"aaaa"};
+
+    auto memo{lexer.memo(input.size())};
+
+    for (std::size_t position{0}; position < input.size(); ++position)
+    {
+        const auto begin{input.begin() + static_cast<std::ptrdiff_t>(position)};
+
+        EXPECT_EQ(lexer.tokenize<Token_kind>(begin, input.end(), memo, position), Result_t(Token_kind::Letter, 1));
+    }
+
+    // A memo holding a single position still yields the same tokens.
+    auto window_memo{lexer.memo(input.size(), 1)};
+
+    for (std::size_t position{0}; position < input.size(); ++position)
+    {
+        const auto begin{input.begin() + static_cast<std::ptrdiff_t>(position)};
+
+        EXPECT_EQ(
+                lexer.tokenize<Token_kind>(begin, input.end(), window_memo, position),
+                Result_t(Token_kind::Letter, 1));
+    }
+
+    const std::string terminated{"aaab"};
+
+    auto terminated_memo{lexer.memo(terminated.size())};
+
+    EXPECT_EQ(
+            lexer.tokenize<Token_kind>(terminated.begin(), terminated.end(), terminated_memo, 0),
+            Result_t(Token_kind::Run, 4));
+}
+
+TEST_F(Lexer_test, Test_timings)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Identifier,
+    };
+
+    Builder builder;
+
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+
+    Timings timings;
+
+    const auto lexer{builder.build(timings)};
+
+    EXPECT_GT(timings.regex_to_nfa.count(), 0);
+    EXPECT_GT(timings.merge.count(), 0);
+    EXPECT_GT(timings.epsilon_closure.count(), 0);
+    EXPECT_GT(timings.subset_construction.count(), 0);
+    EXPECT_GT(timings.minimization.count(), 0);
+    EXPECT_GT(timings.table.count(), 0);
+
+    EXPECT_EQ(
+            timings.total(), timings.regex_to_nfa + timings.merge + timings.epsilon_closure +
+                                     timings.subset_construction + timings.minimization + timings.table);
+
+    Timings unminimized;
+
+    const auto unminimized_lexer{builder.build(unminimized, {.minimize = false})};
+
+    EXPECT_EQ(timings.pruning.count(), 0);
+    EXPECT_EQ(unminimized.minimization.count(), 0);
+    EXPECT_GT(unminimized.pruning.count(), 0);
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    EXPECT_EQ(lexer.tokenize<Token_kind>("int8"), Result_t(Token_kind::Int8, 4));
+    EXPECT_EQ(unminimized_lexer.tokenize<Token_kind>("int8"), Result_t(Token_kind::Int8, 4));
+}
+
+TEST_F(Lexer_test, Test_add_tokens)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Int16,
+        Identifier,
+    };
+
+    using Definition_t = std::tuple<std::shared_ptr<const regex::Regex>, Token_kind, std::size_t>;
+
+    const std::vector<Definition_t> definitions{
+            {text("int8"), Token_kind::Int8, 1},
+            {text("int16"), Token_kind::Int16, 1},
+            {identifier_regex(), Token_kind::Identifier, 4},
+    };
+
+    Builder bulk;
+
+    bulk.add_tokens(definitions);
+
+    Builder single;
+
+    for (const auto& [regex, token, priority] : definitions)
+    {
+        single.add_token(regex, token, priority);
+    }
+
+    const auto bulk_lexer{bulk.build()};
+    const auto single_lexer{single.build()};
+
+    for (const std::string input : {"int8", "int16", "int", "int32", "x", "9"})
+    {
+        EXPECT_EQ(bulk_lexer.tokenize<Token_kind>(input), single_lexer.tokenize<Token_kind>(input)) << input;
+    }
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    EXPECT_EQ(bulk_lexer.tokenize<Token_kind>("int16"), Result_t(Token_kind::Int16, 5));
+
+    const std::vector<Definition_t> invalid{{nullptr, Token_kind::Int8, 1}};
+
+    EXPECT_THROW(bulk.add_tokens(invalid), std::runtime_error);
+}
+
+TEST_F(Lexer_test, Test_precompute_closures)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Identifier,
+        Floating_point_literal,
+    };
+
+    Builder_dbg builder;
+
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+    builder.add_token(floating_point_literal_regex(), Token_kind::Floating_point_literal, 3);
+
+    const auto precomputed{builder.dfa({.minimize = false})};
+    const auto walked{builder.dfa({.minimize = false, .precompute_closures = false})};
+
+    EXPECT_EQ(edge_count(precomputed), edge_count(walked));
+    EXPECT_EQ(precomputed.accept_states().size(), walked.accept_states().size());
+
+    const auto lexer{builder.build()};
+    const auto walked_lexer{builder.build({.precompute_closures = false})};
+
+    for (const std::string input : {"int8", "int", "x_1", "1.5e+3", ".5", "-2.", "+"})
+    {
+        EXPECT_EQ(lexer.tokenize<Token_kind>(input), walked_lexer.tokenize<Token_kind>(input)) << input;
+    }
+}
+
+TEST_F(Lexer_test, Test_range_transitions)
+{
+    enum class Token_kind : uint8_t
+    {
+        If,
+        Identifier,
+    };
+
+    Builder_dbg builder;
+
+    builder.add_token(text("if"), Token_kind::If, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 2);
+
+    // From the initial state, the letters other than 'i' share ranges leading to the same identifier state.
+    const auto dfa{builder.dfa({.minimize = false})};
+
+    // [A-Z], [_], [a-h], [i], [j-z].
+    EXPECT_EQ(dfa.edges(dfa.init_state()).size(), 5);
+
+    const auto lexer{builder.build()};
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    EXPECT_EQ(lexer.tokenize<Token_kind>("if"), Result_t(Token_kind::If, 2));
+    EXPECT_EQ(lexer.tokenize<Token_kind>("iffy"), Result_t(Token_kind::Identifier, 4));
+    EXPECT_EQ(lexer.tokenize<Token_kind>("Zj_9"), Result_t(Token_kind::Identifier, 4));
+}
+
+TEST_F(Lexer_test, Test_high_bytes)
+{
+    enum class Token_kind : uint8_t
+    {
+        Payload,
+        Quoted,
+    };
+
+    Builder builder;
+
+    builder.add_token(plus(any_of(Set::range(0x80, 0xFF))), Token_kind::Payload, 1);
+    builder.add_token(concat(text("\""), kleene(none_of(Set::from('"'))), text("\"")), Token_kind::Quoted, 2);
+
+    const auto lexer{builder.build()};
+
+    using Result_t = Lexer::Result_t<Token_kind>;
+
+    EXPECT_EQ(lexer.tokenize<Token_kind>(std::string{"\x80\xC3\xFF"}), Result_t(Token_kind::Payload, 3));
+    EXPECT_EQ(lexer.tokenize<Token_kind>(std::string{"\"\xFF\x01" "a\"b"}), Result_t(Token_kind::Quoted, 5));
+    EXPECT_EQ(lexer.tokenize<Token_kind>(std::string{"\x7F"}), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Lexer_test, Test_glushkov_construction)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Identifier,
+        Floating_point_literal,
+        Empty,
+    };
+
+    Builder_dbg builder;
+
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+    builder.add_token(floating_point_literal_regex(), Token_kind::Floating_point_literal, 3);
+    builder.add_token(range(text("ab"), 0, 3), Token_kind::Empty, 5);
+
+    Timings timings;
+
+    const auto nfa{builder.position_automaton(timings)};
+
+    for (nfa::Nfa::State_t state{0}; state < nfa.size(); ++state)
+    {
+        EXPECT_TRUE(nfa.epsilon_edges(state).empty());
+    }
+
+    // The minimal DFA of a language is unique, whichever NFA it is built from.
+    const auto thompson{dfa::Table{builder.dfa()}};
+    const auto glushkov{dfa::Table{builder.dfa({.construction = Construction::Glushkov})}};
+
+    EXPECT_EQ(glushkov.size(), thompson.size());
+
+    const auto lexer{builder.build()};
+    const auto glushkov_lexer{builder.build({.construction = Construction::Glushkov})};
+
+    for (const std::string input : {"int8", "int", "x_1", "1.5e+3", ".5", "-2.", "+", "abab", "ababab", "abababab"})
+    {
+        EXPECT_EQ(glushkov_lexer.tokenize<Token_kind>(input), lexer.tokenize<Token_kind>(input)) << input;
+    }
+}
+
+TEST_F(Lexer_test, Test_derivatives_construction)
+{
+    enum class Token_kind : uint8_t
+    {
+        If,
+        Int8,
+        Identifier,
+        Floating_point_literal,
+        Empty,
+        Quoted,
+    };
+
+    Builder_dbg builder;
+
+    builder.add_token(text("if"), Token_kind::If, 1);
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+    builder.add_token(floating_point_literal_regex(), Token_kind::Floating_point_literal, 3);
+    builder.add_token(range(text("ab"), 0, 3), Token_kind::Empty, 5);
+    builder.add_token(concat(text("'"), kleene(any_of(Set::all() - '\'')), text("'")), Token_kind::Quoted, 2);
+
+    Timings timings;
+
+    const auto derivatives{builder.derivatives(timings)};
+
+    EXPECT_GT(timings.derivatives.count(), 0);
+
+    // The minimal DFA of a language is unique, whichever construction it is built by.
+    const auto thompson{dfa::Table{builder.dfa()}};
+    const auto minimal{dfa::Table{builder.dfa({.construction = Construction::Derivatives})}};
+
+    EXPECT_EQ(minimal.size(), thompson.size());
+    EXPECT_GE(dfa::Table{derivatives}.size(), thompson.size());
+
+    const auto lexer{builder.build()};
+    const auto derivatives_lexer{builder.build({.construction = Construction::Derivatives, .minimize = false})};
+
+    for (const std::string input :
+            {"if", "ifx", "int8", "int", "x_1", "1.5e+3", ".5", "-2.", "+", "abab", "ababab", "'a\xff'", "'a", "\xff"})
+    {
+        EXPECT_EQ(derivatives_lexer.tokenize<Token_kind>(input), lexer.tokenize<Token_kind>(input)) << input;
+    }
+}
+
+TEST_F(Lexer_test, Test_comb_layout)
+{
+    enum class Token_kind : uint8_t
+    {
+        Int8,
+        Uint16,
+        Identifier,
+        Integer_literal,
+        String_literal,
+    };
+
+    Builder builder;
+
+    builder.add_token(text("int8"), Token_kind::Int8, 1);
+    builder.add_token(text("uint16"), Token_kind::Uint16, 1);
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+    builder.add_token(integer_literal_regex(), Token_kind::Integer_literal, 2);
+    builder.add_token(string_literal_regex(), Token_kind::String_literal, 3);
+
+    const auto lexer{builder.build()};
+    const auto comb_lexer{builder.build({.layout = Layout::Comb})};
+
+    for (const std::string input : {"int8", "uint16", "uint1", "int8x", "_u8", "42", "\"a b\"", "\"a", "-"})
+    {
+        EXPECT_EQ(comb_lexer.tokenize<Token_kind>(input), lexer.tokenize<Token_kind>(input)) << input;
+
+        auto memo{comb_lexer.memo(input.size())};
+
+        EXPECT_EQ(comb_lexer.tokenize<Token_kind>(input.begin(), input.end(), memo, 0),
+                lexer.tokenize<Token_kind>(input))
+                << input;
+    }
+}
+
+TEST_F(Lexer_test, Test_defaults_layout)
+{
+    enum class Token_kind : uint8_t
+    {
+        Keyword,
+        Identifier,
+        Integer_literal,
+    };
+
+    Builder builder;
+
+    for (const auto* const keyword : {"break", "case", "continue", "default", "double", "return", "switch", "while"})
+    {
+        builder.add_token(text(keyword), Token_kind::Keyword, 1);
+    }
+
+    builder.add_token(identifier_regex(), Token_kind::Identifier, 4);
+    builder.add_token(integer_literal_regex(), Token_kind::Integer_literal, 2);
+
+    const auto lexer{builder.build()};
+    const auto defaults_lexer{builder.build({.layout = Layout::Defaults})};
+
+    // Keyword prefixes only differ from identifiers on their next letter.
+    EXPECT_LT(defaults_lexer.bytes(), lexer.bytes());
+
+    for (const std::string input : {"break", "continue", "cont", "double_", "whilex", "_w8", "42", "-"})
+    {
+        EXPECT_EQ(defaults_lexer.tokenize<Token_kind>(input), lexer.tokenize<Token_kind>(input)) << input;
+
+        auto memo{defaults_lexer.memo(input.size())};
+
+        EXPECT_EQ(defaults_lexer.tokenize<Token_kind>(input.begin(), input.end(), memo, 0),
+                lexer.tokenize<Token_kind>(input))
+                << input;
+    }
+}
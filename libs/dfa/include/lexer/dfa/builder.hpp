@@ -60,7 +60,7 @@ private:
 
     Dfa::State_t next_state_;
 
-    Dfa::Transitions_t transitions_;
+    Dfa::Map_transitions_t transitions_;
 
     Dfa::Accept_states_t accept_states_;
 };
@@ -0,0 +1,73 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_CLASSES_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_CLASSES_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/label.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Partition of the byte alphabet into equivalence classes.
+ *
+ * Two bytes share a class when every DFA state transitions on them to the same destination (or has no transition on
+ * either), so a compiled table only needs one column per class instead of one per byte.
+ */
+class Classes
+{
+public:
+    /**
+     * @brief Type representing a byte class identifier.
+     */
+    using Class_t = std::uint8_t;
+
+    /**
+     * @brief Number of distinct input bytes.
+     */
+    static constexpr std::size_t alphabet_size{std::numeric_limits<Label::Symbol_t>::max() + 1};
+
+    /**
+     * @brief Computes the coarsest byte partition respected by all transitions of a DFA.
+     * @param dfa The DFA to partition the alphabet for.
+     */
+    explicit Classes(const Dfa& dfa);
+
+    /**
+     * @brief Returns the number of byte classes.
+     * @return The number of classes, between 1 and `alphabet_size`.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns the lowest byte belonging to a class.
+     * @param id The class identifier.
+     * @return A byte of the class, usable to probe transitions on behalf of the whole class.
+     */
+    [[nodiscard]] Label::Symbol_t representative(Class_t id) const noexcept;
+
+    /**
+     * @brief Returns the class of an input symbol.
+     * @param symbol The input symbol.
+     * @return The class identifier.
+     */
+    [[nodiscard]] Class_t operator[](const Label::Symbol_t symbol) const noexcept
+    {
+        return classes_[symbol];
+    }
+
+private:
+    std::array<Class_t, alphabet_size> classes_;
+
+    std::size_t size_;
+
+    // The lowest byte of each class, indexed by class identifier.
+    std::vector<Label::Symbol_t> representatives_;
+};
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_CLASSES_HPP
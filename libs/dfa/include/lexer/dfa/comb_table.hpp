@@ -0,0 +1,185 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_COMB_TABLE_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_COMB_TABLE_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "lexer/dfa/classes.hpp"
+#include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/label.hpp"
+#include "lexer/dfa/token.hpp"
+
+namespace lexer::dfa
+{
+class Table;
+
+/**
+ * @brief Compiled, immutable runtime representation of a DFA packing its sparse rows by row displacement.
+ *
+ * Rows of the `state × classes` transition table are overlapped into shared `next`/`check` arrays at a per-state
+ * `base` offset, as in flex's comb-vector encoding: the transition of a state on a class is stored at `base + class`
+ * and is valid only if the `check` entry at that slot names the state. Only the present transitions take space, so
+ * grammars whose states each have few transitions compile to much smaller tables than the dense layout, at the cost of
+ * one more load per input byte.
+ *
+ * States and slots are stored in the narrowest unsigned type holding them: rows are laid out once with wide entries,
+ * and the resulting table narrowed when it fits.
+ *
+ * States keep their identifiers in the dense table rather than being renumbered with the accepting states first as in
+ * `Narrow_table`: this layout trades speed for size, and checking if a state accepts stays a load of its token next
+ * to the extra load of the `check` entry.
+ *
+ * @tparam State The unsigned type of the state identifiers and row offsets.
+ */
+template <std::unsigned_integral State = Dfa::State_t>
+class Comb_table
+{
+public:
+    /**
+     * @brief Type representing a compiled state identifier.
+     */
+    using State_t = State;
+
+    /**
+     * @brief Sentinel state reached on a missing transition, from which no input is accepted.
+     */
+    static constexpr State_t dead_state{std::numeric_limits<State_t>::max()};
+
+    /**
+     * @brief Checks if the states and slots of a comb table with wide entries fit the state type.
+     * @param table The comb table with wide entries.
+     * @return True if every state and every slot is below the dead state.
+     */
+    [[nodiscard]] static bool fits(const Comb_table<>& table) noexcept
+    {
+        return std::max(table.size(), table.next_.size()) < dead_state;
+    }
+
+    /**
+     * @brief Compiles the transition and accept-state maps of a DFA into comb vectors.
+     * @param dfa The DFA to compile.
+     * @throws std::length_error if the states or slots do not fit the state type.
+     */
+    explicit Comb_table(const Dfa& dfa);
+
+    /**
+     * @brief Packs the rows of a dense table into comb vectors.
+     * @param table The dense table of the DFA.
+     * @throws std::length_error if the states or slots do not fit the state type.
+     */
+    explicit Comb_table(const Table& table);
+
+    /**
+     * @brief Narrows the entries of a comb table with wide entries, keeping its layout.
+     * @param table The comb table with wide entries.
+     * @throws std::length_error if the states or slots do not fit the state type.
+     */
+    template <std::same_as<Dfa::State_t> Wide>
+        requires(!std::same_as<State, Wide>)
+    explicit Comb_table(const Comb_table<Wide>& table);
+
+    /**
+     * @brief Returns the initial state of the compiled DFA.
+     * @return The initial state identifier.
+     */
+    [[nodiscard]] State_t init_state() const noexcept { return init_state_; }
+
+    /**
+     * @brief Returns the number of states in the compiled DFA, excluding the dead state.
+     * @return The number of states.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return accept_tokens_.size(); }
+
+    /**
+     * @brief Returns the size of the transition arrays.
+     * @return The number of bytes taken by the base, next and check arrays.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return (base_.size() + next_.size() + check_.size()) * sizeof(State_t);
+    }
+
+    /**
+     * @brief Returns the byte equivalence classes indexing the rows.
+     * @return Reference to the byte classes.
+     */
+    [[nodiscard]] const Classes& classes() const noexcept { return classes_; }
+
+    /**
+     * @brief Returns the index of a live state, in `[0, size())`.
+     * @param state The state, must not be the dead state.
+     * @return The state itself, states being numbered from 0.
+     */
+    [[nodiscard]] std::size_t index(const State_t state) const noexcept { return state; }
+
+    /**
+     * @brief Advances from a live state on an input symbol.
+     * @param state The current state, must not be the dead state.
+     * @param symbol The input symbol.
+     * @return The next state, or `dead_state` if no transition exists.
+     */
+    [[nodiscard]] State_t next(const State_t state, const Label::Symbol_t symbol) const noexcept
+    {
+        const std::size_t slot{base_[state] + std::size_t{classes_[symbol]}};
+
+        return check_[slot] == state ? next_[slot] : dead_state;
+    }
+
+    /**
+     * @brief Checks if a live state is accepting.
+     * @param state The state to check, must not be the dead state.
+     * @return True if the state accepts a token.
+     */
+    [[nodiscard]] bool accepts(const State_t state) const noexcept { return accept_tokens_[state].has_value(); }
+
+    /**
+     * @brief Returns the token accepted by a live state.
+     * @param state The state to check, must not be the dead state.
+     * @return The associated token if the state is accepting, otherwise std::nullopt.
+     */
+    [[nodiscard]] const std::optional<Token>& accept_token(const State_t state) const noexcept
+    {
+        return accept_tokens_[state];
+    }
+
+private:
+    template <std::unsigned_integral>
+    friend class Comb_table;
+
+    Comb_table(State_t init_state,
+            const Classes& classes,
+            std::vector<State_t> base,
+            std::vector<State_t> next,
+            std::vector<State_t> check,
+            std::vector<std::optional<Token>> accept_tokens);
+
+    /**
+     * @brief Packs the rows of a dense table into comb vectors with wide entries.
+     */
+    [[nodiscard]] static Comb_table<> pack(const Table& table);
+
+    State_t init_state_;
+
+    Classes classes_;
+
+    std::vector<State_t> base_;
+
+    std::vector<State_t> next_;
+
+    std::vector<State_t> check_;
+
+    std::vector<std::optional<Token>> accept_tokens_;
+};
+
+extern template class Comb_table<std::uint8_t>;
+extern template class Comb_table<std::uint16_t>;
+extern template class Comb_table<std::uint32_t>;
+extern template class Comb_table<Dfa::State_t>;
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_COMB_TABLE_HPP
@@ -0,0 +1,34 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_CONCEPTS_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_CONCEPTS_HPP
+
+#include <concepts>
+#include <optional>
+
+#include "lexer/dfa/label.hpp"
+#include "lexer/dfa/token.hpp"
+
+namespace lexer::dfa::concepts
+{
+/**
+ * @brief Concept that checks if a type is a compiled DFA that the simulator can run.
+ *
+ * A compiled DFA has an initial state, advances from a live state on a symbol to the next state or to its
+ * `dead_state`, tells whether a live state accepts and which token it accepts, and maps each of its live states to an
+ * index in `[0, size())`.
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept Table = requires(const T& table, const typename T::State_t state, const Label::Symbol_t symbol) {
+    { T::dead_state } -> std::convertible_to<typename T::State_t>;
+    { table.init_state() } -> std::same_as<typename T::State_t>;
+    { table.next(state, symbol) } -> std::same_as<typename T::State_t>;
+    { table.accepts(state) } -> std::same_as<bool>;
+    { table.accept_token(state) } -> std::same_as<const std::optional<Token>&>;
+    { table.size() } -> std::convertible_to<std::size_t>;
+    { table.index(state) } -> std::convertible_to<std::size_t>;
+};
+
+} // namespace lexer::dfa::concepts
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_CONCEPTS_HPP
@@ -0,0 +1,206 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_DEFAULT_TABLE_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_DEFAULT_TABLE_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "lexer/dfa/classes.hpp"
+#include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/label.hpp"
+#include "lexer/dfa/token.hpp"
+
+namespace lexer::dfa
+{
+class Table;
+
+/**
+ * @brief Compiled, immutable runtime representation of a DFA storing each row as its difference to a default state.
+ *
+ * Implements default-transition compression (D²FA): a state may designate a default state, and then only stores the
+ * transitions on which it differs from it, including missing transitions where the default state has one. Lookups
+ * that find no entry for the state continue from its default state. The remaining entries are packed into comb vectors
+ * as in `Comb_table`. Identifier- and keyword-style grammars yield many states agreeing with a sibling state on all
+ * but a few bytes, whose rows then shrink to these few bytes.
+ *
+ * Defaults are only chosen among states whose chain is shorter than the bound given on construction, so a lookup
+ * follows at most that many defaults whatever the DFA. As in `Comb_table`, states and slots are stored in the narrowest
+ * unsigned type holding them.
+ *
+ * Like `Comb_table`, this layout is chosen for size: states are not renumbered with the accepting states first, and
+ * checking if a state accepts reads its token, which costs little next to following a default chain.
+ *
+ * @tparam State The unsigned type of the state identifiers and row offsets.
+ */
+template <std::unsigned_integral State = Dfa::State_t>
+class Default_table
+{
+public:
+    /**
+     * @brief Type representing a compiled state identifier.
+     */
+    using State_t = State;
+
+    /**
+     * @brief Sentinel state reached on a missing transition, from which no input is accepted.
+     */
+    static constexpr State_t dead_state{std::numeric_limits<State_t>::max()};
+
+    /**
+     * @brief The default bound on the number of defaults followed by a lookup.
+     */
+    static constexpr std::size_t chain_depth{2};
+
+    /**
+     * @brief Checks if the states and slots of a default-compressed table with wide entries fit the state type.
+     * @param table The default-compressed table with wide entries.
+     * @return True if every state and every slot is below the dead state.
+     */
+    [[nodiscard]] static bool fits(const Default_table<>& table) noexcept
+    {
+        return std::max(table.size(), table.next_.size()) < dead_state;
+    }
+
+    /**
+     * @brief Compiles the transition and accept-state maps of a DFA into default-compressed comb vectors.
+     * @param dfa The DFA to compile.
+     * @param depth The maximum number of defaults followed by a lookup, 0 disabling default states.
+     * @throws std::length_error if the states or slots do not fit the state type.
+     */
+    explicit Default_table(const Dfa& dfa, std::size_t depth = chain_depth);
+
+    /**
+     * @brief Narrows the entries of a default-compressed table with wide entries, keeping its layout.
+     * @param table The default-compressed table with wide entries.
+     * @throws std::length_error if the states or slots do not fit the state type.
+     */
+    template <std::same_as<Dfa::State_t> Wide>
+        requires(!std::same_as<State, Wide>)
+    explicit Default_table(const Default_table<Wide>& table);
+
+    /**
+     * @brief Returns the initial state of the compiled DFA.
+     * @return The initial state identifier.
+     */
+    [[nodiscard]] State_t init_state() const noexcept { return init_state_; }
+
+    /**
+     * @brief Returns the number of states in the compiled DFA, excluding the dead state.
+     * @return The number of states.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return accept_tokens_.size(); }
+
+    /**
+     * @brief Returns the size of the transition arrays.
+     * @return The number of bytes taken by the base, default, next and check arrays.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return (base_.size() + default_.size() + next_.size() + check_.size()) * sizeof(State_t);
+    }
+
+    /**
+     * @brief Returns the length of the longest chain of default states.
+     * @return The maximum number of defaults followed by a lookup.
+     */
+    [[nodiscard]] std::size_t depth() const noexcept { return depth_; }
+
+    /**
+     * @brief Returns the byte equivalence classes indexing the rows.
+     * @return Reference to the byte classes.
+     */
+    [[nodiscard]] const Classes& classes() const noexcept { return classes_; }
+
+    /**
+     * @brief Returns the index of a live state, in `[0, size())`.
+     * @param state The state, must not be the dead state.
+     * @return The state itself, states being numbered from 0.
+     */
+    [[nodiscard]] std::size_t index(const State_t state) const noexcept { return state; }
+
+    /**
+     * @brief Advances from a live state on an input symbol.
+     * @param state The current state, must not be the dead state.
+     * @param symbol The input symbol.
+     * @return The next state, or `dead_state` if no transition exists.
+     */
+    [[nodiscard]] State_t next(State_t state, const Label::Symbol_t symbol) const noexcept
+    {
+        const std::size_t id{classes_[symbol]};
+
+        while (check_[base_[state] + id] != state)
+        {
+            state = default_[state];
+
+            if (state == dead_state)
+            {
+                return dead_state;
+            }
+        }
+
+        return next_[base_[state] + id];
+    }
+
+    /**
+     * @brief Checks if a live state is accepting.
+     * @param state The state to check, must not be the dead state.
+     * @return True if the state accepts a token.
+     */
+    [[nodiscard]] bool accepts(const State_t state) const noexcept { return accept_tokens_[state].has_value(); }
+
+    /**
+     * @brief Returns the token accepted by a live state.
+     * @param state The state to check, must not be the dead state.
+     * @return The associated token if the state is accepting, otherwise std::nullopt.
+     */
+    [[nodiscard]] const std::optional<Token>& accept_token(const State_t state) const noexcept
+    {
+        return accept_tokens_[state];
+    }
+
+private:
+    template <std::unsigned_integral>
+    friend class Default_table;
+
+    Default_table(State_t init_state,
+            const Classes& classes,
+            std::size_t depth,
+            std::vector<State_t> base,
+            std::vector<State_t> defaults,
+            std::vector<State_t> next,
+            std::vector<State_t> check,
+            std::vector<std::optional<Token>> accept_tokens);
+
+    /**
+     * @brief Chooses the default state of every row of a dense table and packs the differences with wide entries.
+     */
+    [[nodiscard]] static Default_table<> pack(const Table& table, std::size_t depth);
+
+    State_t init_state_;
+
+    Classes classes_;
+
+    std::size_t depth_;
+
+    std::vector<State_t> base_;
+
+    std::vector<State_t> default_;
+
+    std::vector<State_t> next_;
+
+    std::vector<State_t> check_;
+
+    std::vector<std::optional<Token>> accept_tokens_;
+};
+
+extern template class Default_table<std::uint8_t>;
+extern template class Default_table<std::uint16_t>;
+extern template class Default_table<std::uint32_t>;
+extern template class Default_table<Dfa::State_t>;
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_DEFAULT_TABLE_HPP
@@ -2,7 +2,9 @@
 #define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_DFA_HPP
 
 #include <optional>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 #include "lexer/dfa/label.hpp"
 #include "lexer/dfa/token.hpp"
@@ -12,7 +14,11 @@ namespace lexer::dfa
 /**
  * @brief Represents a deterministic finite automaton (DFA).
  *
- * Provides methods for querying states, transitions, and accept states, as well as advancing the DFA.
+ * Provides methods for querying states, transitions, and accept states, as well as advancing the DFA. Transitions are
+ * labeled with symbol ranges, which must not overlap among the transitions leaving a state.
+ *
+ * The transitions are only stored as the edges of each state; the map-based transition table is kept by the Builder,
+ * and the accessor and types that exposed it on the DFA are deprecated and rebuild the table on demand.
  */
 class Dfa
 {
@@ -22,27 +28,38 @@ public:
      */
     using State_t = std::size_t;
 
+private:
+    friend class Builder;
+
+    // The transition table a Builder assembles a DFA in.
+    using Map_key_t = std::pair<State_t, Label>;
+
+    struct Map_hash
+    {
+        std::size_t operator()(const Map_key_t& key) const noexcept;
+    };
+
+    using Map_transitions_t = std::unordered_map<Map_key_t, State_t, Map_hash>;
+
+public:
     /**
      * @brief DFA transition key type.
-     *
-     * Represents a pair of `(from_state, Label)` used as the key in transition maps.
+     * @deprecated The DFA stores its transitions as edges; use edges() instead.
      */
-    using Key_t = std::pair<State_t, Label>;
+    using Key_t [[deprecated("The DFA stores its transitions as edges; use edges() instead")]] = Map_key_t;
 
     /**
      * @brief Hash functor for computing transition key hashes.
+     * @deprecated The DFA stores its transitions as edges; use edges() instead.
      */
-    struct Hash
-    {
-        std::size_t operator()(const Key_t& key) const noexcept;
-    };
+    using Hash [[deprecated("The DFA stores its transitions as edges; use edges() instead")]] = Map_hash;
 
     /**
      * @brief Transition table for the DFA.
-     *
-     * Maps `(state, label)` pairs to a deterministic destination state.
+     * @deprecated The DFA stores its transitions as edges; use edges() instead.
      */
-    using Transitions_t = std::unordered_map<Key_t, State_t, Hash>;
+    using Transitions_t [[deprecated("The DFA stores its transitions as edges; use edges() instead")]] =
+            Map_transitions_t;
 
     /**
      * @brief Accept-state table for the DFA.
@@ -51,13 +68,29 @@ public:
      */
     using Accept_states_t = std::unordered_map<State_t, Token>;
 
+    /**
+     * @brief Range transition in the per-state adjacency layout.
+     */
+    struct Edge
+    {
+        /**
+         * @brief The range of symbols taking the transition.
+         */
+        Label label;
+
+        /**
+         * @brief The destination state.
+         */
+        State_t to;
+    };
+
     /**
      * @brief Constructs a DFA with the given initial state, transitions, and accept states.
      * @param init_state The initial state of the DFA.
-     * @param transitions The transition table.
+     * @param transitions The transition table of a Builder, laid out into the per-state edges.
      * @param accept_states The accept states and their associated tokens.
      */
-    Dfa(State_t init_state, Transitions_t transitions, Accept_states_t accept_states);
+    Dfa(State_t init_state, const Map_transitions_t& transitions, Accept_states_t accept_states);
 
     /**
      * @brief Returns the initial state of the DFA.
@@ -67,9 +100,11 @@ public:
 
     /**
      * @brief Returns the transition table of the DFA.
-     * @return Reference to the transitions map.
+     * @return The transitions map, rebuilt from the edges on every call.
+     * @deprecated The DFA stores its transitions as edges; use edges() instead.
      */
-    [[nodiscard]] const Transitions_t& transitions() const noexcept;
+    [[deprecated("The DFA stores its transitions as edges; use edges() instead")]] [[nodiscard]] Map_transitions_t
+    transitions() const;
 
     /**
      * @brief Returns the accept states and their associated tokens.
@@ -77,14 +112,27 @@ public:
      */
     [[nodiscard]] const Accept_states_t& accept_states() const noexcept;
 
+    /**
+     * @brief Returns the number of states of the DFA.
+     * @return One past the highest state identifier.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns the outgoing transitions of a state.
+     * @param state The state, which must not exceed the largest state referenced by the DFA.
+     * @return The edges, ordered by the first symbol of their range.
+     */
+    [[nodiscard]] std::span<const Edge> edges(State_t state) const noexcept;
+
     /**
      * @brief Advances the DFA from a given state on an input symbol.
      * @param dfa The DFA to advance.
      * @param state The current state.
      * @param symbol The input symbol.
-     * @return The next state if a transition exists, otherwise std::nullopt.
+     * @return The next state if a transition range contains the symbol, otherwise std::nullopt.
      */
-    [[nodiscard]] static std::optional<State_t> advance(const Dfa& dfa, State_t state, char symbol);
+    [[nodiscard]] static std::optional<State_t> advance(const Dfa& dfa, State_t state, Label::Symbol_t symbol);
 
     /**
      * @brief Checks if a state is an accept state and returns its token if so.
@@ -97,7 +145,11 @@ public:
 private:
     State_t init_state_;
 
-    Transitions_t transitions_;
+    // The edges of state `s` are `edges_[edge_offsets_[s], edge_offsets_[s + 1])`. The ranges leaving a state are
+    // disjoint, so a symbol is matched by the last edge whose range starts at or below it, if any.
+    std::vector<std::size_t> edge_offsets_;
+
+    std::vector<Edge> edges_;
 
     Accept_states_t accept_states_;
 };
@@ -1,12 +1,15 @@
 #ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_LABEL_HPP
 #define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_LABEL_HPP
 
+#include <cstdint>
 #include <functional>
 
 namespace lexer::dfa
 {
 /**
- * @brief Represents a transition label (symbol) for DFA transitions.
+ * @brief Represents a transition label (symbol range) for DFA transitions.
+ *
+ * A label matches every symbol of the closed range `[first, last]`.
  */
 class Label
 {
@@ -14,31 +17,63 @@ public:
     /**
      * @brief Symbol type for DFA labels.
      *
-     * Each label represents a single input character used on transitions.
+     * Each label represents a range of input bytes used on transitions; input characters are read as unsigned bytes.
      */
-    using Symbol_t = char;
+    using Symbol_t = std::uint8_t;
 
     /**
-     * @brief Constructs a label with the given symbol.
+     * @brief Constructs a label matching a single symbol.
      * @param s The symbol for the label.
      */
     explicit Label(Symbol_t s) noexcept;
 
     /**
-     * @brief Returns the symbol associated with this label.
-     * @return The symbol character.
+     * @brief Constructs a label matching a closed range of symbols.
+     * @param first The lowest symbol of the range.
+     * @param last The highest symbol of the range.
+     * @throws std::invalid_argument if `first` is greater than `last`.
      */
-    [[nodiscard]] Symbol_t symbol() const noexcept;
+    Label(Symbol_t first, Symbol_t last);
+
+    /**
+     * @brief Returns the lowest symbol matched by this label.
+     * @return The first symbol of the range.
+     */
+    [[nodiscard]] Symbol_t first() const noexcept;
+
+    /**
+     * @brief Returns the highest symbol matched by this label.
+     * @return The last symbol of the range.
+     */
+    [[nodiscard]] Symbol_t last() const noexcept;
+
+    /**
+     * @brief Returns the symbol of a single-symbol label.
+     * @return The first symbol of the range.
+     * @pre The label matches a single symbol, i.e. `first() == last()`.
+     * @deprecated Labels match symbol ranges; use first() and last() instead.
+     */
+    [[deprecated("Labels match symbol ranges; use first() and last() instead")]] [[nodiscard]] Symbol_t symbol()
+            const noexcept;
+
+    /**
+     * @brief Checks if the label matches a symbol.
+     * @param symbol The symbol to check.
+     * @return True if the symbol lies within the range.
+     */
+    [[nodiscard]] bool contains(Symbol_t symbol) const noexcept;
 
     /**
      * @brief Equality comparison operator for labels.
      * @param other The label to compare with.
-     * @return True if the symbols are equal, false otherwise.
+     * @return True if both ranges are equal, false otherwise.
      */
     bool operator==(const Label& other) const noexcept;
 
 private:
-    Symbol_t symbol_;
+    Symbol_t first_;
+
+    Symbol_t last_;
 };
 
 } // namespace lexer::dfa
@@ -51,7 +86,7 @@ struct std::hash<lexer::dfa::Label>
 {
     std::size_t operator()(const lexer::dfa::Label& label) const noexcept
     {
-        return std::hash<decltype(label.symbol())>{}(label.symbol());
+        return static_cast<std::size_t>(label.first()) << 8 | label.last();
     }
 };
 
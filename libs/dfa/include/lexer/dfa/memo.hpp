@@ -0,0 +1,101 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_MEMO_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_MEMO_HPP
+
+#include <utility>
+#include <vector>
+
+#include "lexer/dfa/table.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Memo of failed `(state, position)` pairs for linear-time longest-match tokenization.
+ *
+ * Implements the memoization of Reps' "maximal-munch" algorithm: when a scan ends, every pair visited after its last
+ * accepting position is known not to reach an accepting state, so later scans over the same input stop as soon as they
+ * reach one of those pairs. Each pair fails at most once, which bounds the total work of tokenizing an input to
+ * `O(states × length)`. States are recorded by their index in the compiled DFA.
+ *
+ * Recording every pair of an input would take `(length + 1) × states` bits, hundreds of megabytes for a large input and
+ * a DFA of a few thousand states. The memo therefore only holds a window of `capacity / states` positions, starting at
+ * the position of the current scan: positions behind it are never queried again by scans at increasing positions, and
+ * pairs beyond it are simply not recorded. The work stays linear as long as the scans ending in a failure fit in the
+ * window.
+ */
+class Memo
+{
+public:
+    /**
+     * @brief The default number of pairs held by a memo, 16 MiB worth of bits.
+     */
+    static constexpr std::size_t default_capacity{std::size_t{1} << 27};
+
+    /**
+     * @brief Constructs an empty memo for an input.
+     * @param states The number of states of the compiled DFA.
+     * @param length The length of the input, positions being offsets in `[0, length]`.
+     * @param capacity The largest number of pairs to hold, which bounds the memory of the memo.
+     */
+    Memo(std::size_t states, std::size_t length, std::size_t capacity = default_capacity);
+
+    /**
+     * @brief Starts a scan, moving the window to the position the scan starts at.
+     *
+     * Pairs at positions the window moves past are dropped. Moving back, as when rescanning an input from its start,
+     * drops every pair.
+     *
+     * @param position The input position at which the scan starts.
+     */
+    void seek(std::size_t position);
+
+    /**
+     * @brief Checks if a pair is known not to reach an accepting state.
+     * @param state The index of the DFA state.
+     * @param position The input position at which the state is entered.
+     * @return True if the pair has failed in a previous scan.
+     */
+    [[nodiscard]] bool failed(const Table::State_t state, const std::size_t position) const
+    {
+        return position - base_ < window_ && failed_[(position % window_) * states_ + state];
+    }
+
+    /**
+     * @brief Records a pair visited by the current scan after its last accepting position.
+     * @param state The index of the DFA state.
+     * @param position The input position at which the state is entered.
+     */
+    void visit(const Table::State_t state, const std::size_t position)
+    {
+        if (position - base_ < window_)
+        {
+            visited_.emplace_back(state, position);
+        }
+    }
+
+    /**
+     * @brief Discards the pairs visited so far, as the current scan has reached an accepting state.
+     */
+    void accept() noexcept { visited_.clear(); }
+
+    /**
+     * @brief Ends the current scan, marking all pairs visited after its last accepting position as failed.
+     */
+    void fail();
+
+private:
+    std::size_t states_;
+
+    // Number of positions held, the pairs of position `p` being stored in row `p % window_`.
+    std::size_t window_;
+
+    // First position of the window.
+    std::size_t base_;
+
+    std::vector<bool> failed_;
+
+    std::vector<std::pair<Table::State_t, std::size_t>> visited_;
+};
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_MEMO_HPP
@@ -0,0 +1,22 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_MINIMIZE_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_MINIMIZE_HPP
+
+#include "lexer/dfa/dfa.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Minimizes a DFA using Hopcroft's partition refinement.
+ *
+ * States are merged only when they accept the same token and agree on every transition, so states accepting different
+ * token ids are kept apart. States equivalent to the implicit dead state, i.e. from which no token can be accepted,
+ * are removed together with the transitions leading into them, as are unreachable states.
+ *
+ * @param dfa The DFA to minimize.
+ * @return The equivalent DFA with the minimal number of states, numbered in breadth-first order from the initial state.
+ */
+[[nodiscard]] Dfa minimize(const Dfa& dfa);
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_MINIMIZE_HPP
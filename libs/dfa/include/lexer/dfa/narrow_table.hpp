@@ -0,0 +1,202 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_NARROW_TABLE_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_NARROW_TABLE_HPP
+
+#include <concepts>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "lexer/dfa/classes.hpp"
+#include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/label.hpp"
+#include "lexer/dfa/table.hpp"
+#include "lexer/dfa/token.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Compiled, immutable runtime representation of a DFA with narrow, premultiplied state identifiers.
+ *
+ * Lays out the same dense `state × classes` array as `Table`, but each state is identified by the offset of its row,
+ * stored in the narrowest unsigned type able to hold it. Advancing on an input byte is then `transitions[state +
+ * class]`, with no multiplication, over a table that takes a half, a quarter or an eighth of the wide one. Rows are not
+ * padded: the index of a state is its offset divided by the number of classes, which is only computed to look up the
+ * token of an accepting state or to record a state in a memo.
+ *
+ * States are renumbered so that the accepting states come first, followed by the other live states, the dead state
+ * being the largest identifier. Checking if a state accepts is then a single comparison, and the accepted tokens are
+ * only looked up, in a flat array over the accepting states, on that rare path.
+ *
+ * @tparam State The unsigned type of the state identifiers.
+ */
+template <std::unsigned_integral State>
+class Narrow_table
+{
+public:
+    /**
+     * @brief Type representing a compiled state identifier, the offset of its row.
+     */
+    using State_t = State;
+
+    /**
+     * @brief Sentinel state reached on a missing transition, from which no input is accepted.
+     */
+    static constexpr State_t dead_state{std::numeric_limits<State_t>::max()};
+
+    /**
+     * @brief Checks if the premultiplied identifiers of a compiled DFA fit the state type.
+     * @param table The dense table of the DFA.
+     * @return True if every row offset is below the dead state.
+     */
+    [[nodiscard]] static bool fits(const Table& table) noexcept
+    {
+        return (table.size() - 1) * table.classes().size() < dead_state;
+    }
+
+    /**
+     * @brief Compiles the transition and accept-state maps of a DFA into a narrow table.
+     * @param dfa The DFA to compile.
+     * @throws std::length_error if the state identifiers do not fit the state type.
+     */
+    explicit Narrow_table(const Dfa& dfa) : Narrow_table{Table{dfa}} {}
+
+    /**
+     * @brief Narrows the identifiers of a dense table.
+     * @param table The dense table of the DFA.
+     * @throws std::length_error if the state identifiers do not fit the state type.
+     */
+    explicit Narrow_table(const Table& table) : classes_{table.classes()}, stride_{classes_.size()}
+    {
+        if (!fits(table))
+        {
+            throw std::length_error("DFA state identifiers do not fit the narrow table state type");
+        }
+
+        // The accepting states keep their relative order in front of the other states, which keep theirs.
+        std::vector<State_t> numbers(table.size());
+
+        std::size_t accepting{0};
+
+        for (Table::State_t state{0}; state < table.size(); ++state)
+        {
+            if (table.accept_token(state))
+            {
+                numbers[state] = static_cast<State_t>(accepting++ * stride_);
+
+                accept_tokens_.push_back(table.accept_token(state));
+            }
+        }
+
+        accept_limit_ = accepting * stride_;
+
+        for (Table::State_t state{0}; state < table.size(); ++state)
+        {
+            if (!table.accept_token(state))
+            {
+                numbers[state] = static_cast<State_t>(accepting++ * stride_);
+            }
+        }
+
+        init_state_ = numbers[table.init_state()];
+
+        transitions_.assign(table.size() * stride_, dead_state);
+
+        for (Table::State_t state{0}; state < table.size(); ++state)
+        {
+            for (std::size_t id{0}; id < classes_.size(); ++id)
+            {
+                const auto to{table.next(state, classes_.representative(static_cast<Classes::Class_t>(id)))};
+
+                if (to != Table::dead_state)
+                {
+                    transitions_[numbers[state] + id] = numbers[to];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the initial state of the compiled DFA.
+     * @return The initial state identifier.
+     */
+    [[nodiscard]] State_t init_state() const noexcept { return init_state_; }
+
+    /**
+     * @brief Returns the number of states in the compiled DFA, excluding the dead state.
+     * @return The number of states.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return transitions_.size() / stride_; }
+
+    /**
+     * @brief Returns the size of the transition array.
+     * @return The number of bytes taken by the transition array.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept { return transitions_.size() * sizeof(State_t); }
+
+    /**
+     * @brief Returns the byte equivalence classes indexing the table columns.
+     * @return Reference to the byte classes.
+     */
+    [[nodiscard]] const Classes& classes() const noexcept { return classes_; }
+
+    /**
+     * @brief Returns the index of a live state, in `[0, size())`.
+     * @param state The state, must not be the dead state.
+     * @return The index of its row.
+     */
+    [[nodiscard]] std::size_t index(const State_t state) const noexcept { return state / stride_; }
+
+    /**
+     * @brief Advances from a live state on an input symbol.
+     * @param state The current state, must not be the dead state.
+     * @param symbol The input symbol.
+     * @return The next state, or `dead_state` if no transition exists.
+     */
+    [[nodiscard]] State_t next(const State_t state, const Label::Symbol_t symbol) const noexcept
+    {
+        return transitions_[state + classes_[symbol]];
+    }
+
+    /**
+     * @brief Checks if a live state is accepting.
+     * @param state The state to check, must not be the dead state.
+     * @return True if the state accepts a token.
+     */
+    [[nodiscard]] bool accepts(const State_t state) const noexcept { return state < accept_limit_; }
+
+    /**
+     * @brief Returns the token accepted by a live state.
+     * @param state The state to check, must not be the dead state.
+     * @return The associated token if the state is accepting, otherwise std::nullopt.
+     */
+    [[nodiscard]] const std::optional<Token>& accept_token(const State_t state) const noexcept
+    {
+        return accepts(state) ? accept_tokens_[index(state)] : no_token;
+    }
+
+private:
+    /**
+     * @brief The token of the non-accepting states.
+     */
+    static constexpr std::optional<Token> no_token{};
+
+    State_t init_state_{0};
+
+    Classes classes_;
+
+    /**
+     * @brief The length of a row, the number of classes, premultiplying the state indices.
+     */
+    std::size_t stride_;
+
+    std::size_t accept_limit_{0};
+
+    std::vector<State_t> transitions_;
+
+    std::vector<std::optional<Token>> accept_tokens_;
+};
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_NARROW_TABLE_HPP
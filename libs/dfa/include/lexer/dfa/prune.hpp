@@ -0,0 +1,24 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_PRUNE_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_PRUNE_HPP
+
+#include "lexer/dfa/dfa.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Removes the states of a DFA that cannot contribute to a match.
+ *
+ * A state is kept if it is reachable from the initial state and some accepting state is reachable from it. The
+ * transitions into unproductive states are dropped, so that a simulation dies on the first symbol after which no
+ * token can be accepted instead of consuming input until its end. Unlike `minimize`, equivalent states are not merged,
+ * which keeps the cost linear in the size of the DFA.
+ *
+ * @param dfa The DFA to prune.
+ * @return The equivalent DFA without unreachable and unproductive states, the initial state being kept in any case,
+ * numbered in breadth-first order from the initial state.
+ */
+[[nodiscard]] Dfa prune(const Dfa& dfa);
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_PRUNE_HPP
@@ -1,17 +1,23 @@
 #ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_SIMULATOR_HPP
 #define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_SIMULATOR_HPP
 
+#include <iterator>
+#include <memory>
 #include <optional>
 
 #include "lexer/common/concepts.hpp"
+#include "lexer/dfa/concepts.hpp"
 #include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/memo.hpp"
+#include "lexer/dfa/table.hpp"
 
 namespace lexer::dfa
 {
 /**
  * @brief Simulator for running a DFA over an input sequence.
  *
- * Provides static methods to simulate DFA execution over iterators or containers.
+ * Provides static methods to simulate DFA execution over iterators or containers, either walking the transition map
+ * of a `Dfa` or indexing any of its compiled layouts.
  */
 class Simulator
 {
@@ -21,6 +27,28 @@ public:
      */
     using Result_t = std::pair<std::optional<Token>, std::size_t>;
 
+    /**
+     * @brief The result of a scan over a single-pass input.
+     */
+    struct Scan_result
+    {
+        /**
+         * @brief The matched token (if any).
+         */
+        std::optional<Token> token;
+
+        /**
+         * @brief The length of the match.
+         */
+        std::size_t length;
+
+        /**
+         * @brief The number of symbols consumed from the input, at least `length`; the symbols consumed past the match
+         * belong to the next token.
+         */
+        std::size_t consumed;
+    };
+
     /**
      * @brief Runs the DFA simulation over a range defined by iterators.
      * @tparam Iterator Input iterator type.
@@ -41,22 +69,172 @@ public:
 
         Result_t result{Dfa::has_accept_token(dfa, *state), 0};
 
-        for (Iterator current = begin; current != end && state; ++current)
+        std::size_t length{0};
+
+        for (Iterator current = begin; current != end; ++current)
         {
             if (state = Dfa::advance(dfa, *state, *current); !state)
             {
-                continue;
+                break;
             }
 
+            ++length;
+
             if (const auto token = Dfa::has_accept_token(dfa, *state); token)
             {
-                result = {token, std::distance(begin, current) + 1};
+                result = {token, length};
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Runs the compiled DFA simulation over a range defined by iterators.
+     *
+     * Contiguous ranges are scanned through raw pointers; other ranges are read once, in order, so single-pass
+     * iterators are supported but lose the symbols consumed past the match (see scan()).
+     *
+     * @tparam Compiled The compiled DFA type.
+     * @tparam Iterator Input iterator type.
+     * @param table The compiled DFA to simulate.
+     * @param begin Iterator to the beginning of the input.
+     * @param end Iterator to the end of the input.
+     * @return A pair containing the matched token (if any) and the length of the match.
+     */
+    template <concepts::Table Compiled, common::concepts::Iterator Iterator>
+    [[nodiscard]] static Result_t run(const Compiled& table, Iterator begin, Iterator end)
+    {
+        if constexpr (std::contiguous_iterator<Iterator>)
+        {
+            const auto first{std::to_address(begin)};
+
+            return run_contiguous(table, first, first + (end - begin));
+        }
+        else
+        {
+            const auto [token, length, consumed]{scan(table, begin, end, Discard{})};
+
+            return {token, length};
+        }
+    }
+
+    /**
+     * @brief Runs the compiled DFA simulation over a single-pass input.
+     *
+     * Reads each symbol once and never rewinds, so it works with iterators such as `std::istreambuf_iterator`. The
+     * simulation runs until the DFA dies, thus the symbols consumed past the longest match are lost to the input and
+     * are reported through `output` for the caller to buffer. The symbol on which the DFA dies is dereferenced but
+     * not consumed.
+     *
+     * @tparam Compiled The compiled DFA type.
+     * @tparam Iterator Input iterator type.
+     * @tparam Output Output iterator type receiving the consumed symbols.
+     * @param table The compiled DFA to simulate.
+     * @param begin Iterator to the beginning of the input.
+     * @param end Iterator to the end of the input.
+     * @param output Output iterator receiving every consumed symbol, in order.
+     * @return The matched token (if any), the length of the match, and the number of consumed symbols.
+     */
+    template <concepts::Table Compiled,
+            common::concepts::Iterator Iterator,
+            std::output_iterator<std::iter_value_t<Iterator>> Output>
+    static Scan_result scan(const Compiled& table, Iterator begin, Iterator end, Output output)
+    {
+        if (begin == end)
+        {
+            return {std::nullopt, 0, 0};
+        }
+
+        auto state{table.init_state()};
+
+        Scan_result result{table.accept_token(state), 0, 0};
+
+        for (Iterator current = begin; current != end; ++current)
+        {
+            const auto symbol{*current};
+
+            if (state = table.next(state, symbol); state == Compiled::dead_state)
+            {
+                break;
+            }
+
+            *output++ = symbol;
+
+            if (table.accepts(state))
+            {
+                result.token = table.accept_token(state);
+                result.length = result.consumed + 1;
             }
+
+            ++result.consumed;
         }
 
         return result;
     }
 
+    /**
+     * @brief Runs the compiled DFA simulation over a range, skipping work already proven futile by earlier scans.
+     *
+     * Returns the same result as the non-memoized overload, but stops as soon as the scan reaches a `(state, position)`
+     * pair recorded as failed in the memo, and records the pairs visited after the last accepting position when the
+     * scan ends. Repeatedly scanning an input at increasing positions with the same memo takes linear time overall.
+     *
+     * @tparam Compiled The compiled DFA type.
+     * @tparam Iterator Input iterator type.
+     * @param table The compiled DFA to simulate.
+     * @param begin Iterator to the beginning of the input.
+     * @param end Iterator to the end of the input.
+     * @param memo The memo of failed pairs for the whole input.
+     * @param position The position of `begin` within the input the memo was created for.
+     * @return A pair containing the matched token (if any) and the length of the match.
+     */
+    template <concepts::Table Compiled, common::concepts::Iterator Iterator>
+    [[nodiscard]] static Result_t run(
+            const Compiled& table, Iterator begin, Iterator end, Memo& memo, const std::size_t position)
+    {
+        if (begin == end)
+        {
+            return {std::nullopt, 0};
+        }
+
+        memo.seek(position);
+
+        auto state{table.init_state()};
+
+        Result_t result{table.accept_token(state), 0};
+
+        result.first ? memo.accept() : memo.visit(table.index(state), position);
+
+        std::size_t length{0};
+
+        for (Iterator current = begin; current != end; ++current)
+        {
+            ++length;
+
+            if (state = table.next(state, *current);
+                state == Compiled::dead_state || memo.failed(table.index(state), position + length))
+            {
+                break;
+            }
+
+            if (table.accepts(state))
+            {
+                result = {table.accept_token(state), length};
+
+                memo.accept();
+            }
+            else
+            {
+                memo.visit(table.index(state), position + length);
+            }
+        }
+
+        memo.fail();
+
+        return result;
+    }
+
     /**
      * @brief Runs the DFA simulation over a container.
      * @tparam Container The container type (must be iterable).
@@ -69,6 +247,74 @@ public:
     {
         return run(dfa, std::begin(container), std::end(container));
     }
+
+    /**
+     * @brief Runs the compiled DFA simulation over a container.
+     * @tparam Compiled The compiled DFA type.
+     * @tparam Container The container type (must be iterable).
+     * @param table The compiled DFA to simulate.
+     * @param container The input container.
+     * @return A pair containing the matched token (if any) and the length of the match.
+     */
+    template <concepts::Table Compiled, common::concepts::Iterable Container>
+    [[nodiscard]] static Result_t run(const Compiled& table, const Container& container)
+    {
+        return run(table, std::begin(container), std::end(container));
+    }
+
+private:
+    /**
+     * @brief Output iterator discarding the symbols consumed by a scan.
+     */
+    struct Discard
+    {
+        using difference_type = std::ptrdiff_t;
+
+        Discard& operator*() noexcept { return *this; }
+
+        Discard& operator++() noexcept { return *this; }
+
+        Discard operator++(int) noexcept { return *this; }
+
+        template <typename T>
+        Discard& operator=(const T&) noexcept
+        {
+            return *this;
+        }
+    };
+
+    template <concepts::Table Compiled, typename Symbol>
+    [[nodiscard]] static Result_t run_contiguous(
+            const Compiled& table, const Symbol* const begin, const Symbol* const end)
+    {
+        if (begin == end)
+        {
+            return {std::nullopt, 0};
+        }
+
+        auto state{table.init_state()};
+
+        // The token is looked up once, for the last accepting state or else the initial state, which has none.
+        auto last{state};
+
+        const Symbol* accepted{begin};
+
+        for (const Symbol* current = begin; current != end; ++current)
+        {
+            if (state = table.next(state, *current); state == Compiled::dead_state)
+            {
+                break;
+            }
+
+            if (table.accepts(state))
+            {
+                last = state;
+                accepted = current + 1;
+            }
+        }
+
+        return {table.accept_token(last), static_cast<std::size_t>(accepted - begin)};
+    }
 };
 
 } // namespace lexer::dfa
@@ -0,0 +1,116 @@
+#ifndef LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_TABLE_HPP
+#define LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_TABLE_HPP
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "lexer/dfa/classes.hpp"
+#include "lexer/dfa/dfa.hpp"
+#include "lexer/dfa/label.hpp"
+#include "lexer/dfa/token.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Compiled, immutable runtime representation of a DFA.
+ *
+ * Input bytes are first mapped to their equivalence class, and the transition function is stored as a contiguous
+ * `state × classes` array of next-state identifiers, so advancing on an input byte is two indexed loads into tables
+ * small enough to stay cache resident. Missing transitions lead to the dedicated dead state.
+ *
+ * States keep the identifiers of the DFA, as the sparse layouts and `Narrow_table` are compiled from this table and
+ * address its rows by them. Checking if a state accepts therefore loads its optional token; only `Narrow_table`
+ * numbers the accepting states first to turn that check into a comparison.
+ */
+class Table
+{
+public:
+    /**
+     * @brief Type representing a compiled state identifier.
+     */
+    using State_t = Dfa::State_t;
+
+    /**
+     * @brief Sentinel state reached on a missing transition, from which no input is accepted.
+     */
+    static constexpr State_t dead_state{std::numeric_limits<State_t>::max()};
+
+    /**
+     * @brief Compiles the transition and accept-state maps of a DFA into a dense table.
+     * @param dfa The DFA to compile.
+     */
+    explicit Table(const Dfa& dfa);
+
+    /**
+     * @brief Returns the initial state of the compiled DFA.
+     * @return The initial state identifier.
+     */
+    [[nodiscard]] State_t init_state() const noexcept;
+
+    /**
+     * @brief Returns the number of states in the compiled DFA, excluding the dead state.
+     * @return The number of states.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns the size of the transition array.
+     * @return The number of bytes taken by the transition array.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+    /**
+     * @brief Returns the byte equivalence classes indexing the table columns.
+     * @return Reference to the byte classes.
+     */
+    [[nodiscard]] const Classes& classes() const noexcept;
+
+    /**
+     * @brief Returns the index of a live state, in `[0, size())`.
+     * @param state The state, must not be the dead state.
+     * @return The state itself, states being numbered from 0.
+     */
+    [[nodiscard]] std::size_t index(const State_t state) const noexcept { return state; }
+
+    /**
+     * @brief Advances from a live state on an input symbol.
+     * @param state The current state, must not be the dead state.
+     * @param symbol The input symbol.
+     * @return The next state, or `dead_state` if no transition exists.
+     */
+    [[nodiscard]] State_t next(const State_t state, const Label::Symbol_t symbol) const noexcept
+    {
+        return transitions_[state * classes_.size() + classes_[symbol]];
+    }
+
+    /**
+     * @brief Checks if a live state is accepting.
+     * @param state The state to check, must not be the dead state.
+     * @return True if the state accepts a token.
+     */
+    [[nodiscard]] bool accepts(const State_t state) const noexcept { return accept_tokens_[state].has_value(); }
+
+    /**
+     * @brief Returns the token accepted by a live state.
+     * @param state The state to check, must not be the dead state.
+     * @return The associated token if the state is accepting, otherwise std::nullopt.
+     */
+    [[nodiscard]] const std::optional<Token>& accept_token(const State_t state) const noexcept
+    {
+        return accept_tokens_[state];
+    }
+
+private:
+    State_t init_state_;
+
+    Classes classes_;
+
+    std::vector<State_t> transitions_;
+
+    std::vector<std::optional<Token>> accept_tokens_;
+};
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_INCLUDE_LEXER_DFA_TABLE_HPP
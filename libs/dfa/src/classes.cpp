@@ -0,0 +1,59 @@
+#include "lexer/dfa/classes.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+
+namespace lexer::dfa
+{
+Classes::Classes(const Dfa& dfa) : classes_{}, size_{1}
+{
+    // Refine the partition state by state: bytes stay together only while they agree on every destination so far.
+    for (Dfa::State_t state{0}; state < dfa.size(); ++state)
+    {
+        const auto edges{dfa.edges(state)};
+
+        if (edges.empty())
+        {
+            continue;
+        }
+
+        std::array<std::optional<Dfa::State_t>, alphabet_size> destinations{};
+
+        for (const auto& [label, to] : edges)
+        {
+            std::fill(destinations.begin() + label.first(), destinations.begin() + label.last() + 1, to);
+        }
+
+        std::map<std::pair<Class_t, std::optional<Dfa::State_t>>, Class_t> refined;
+
+        for (std::size_t symbol{0}; symbol < alphabet_size; ++symbol)
+        {
+            const auto key{std::pair{classes_[symbol], destinations[symbol]}};
+
+            classes_[symbol] = refined.emplace(key, static_cast<Class_t>(refined.size())).first->second;
+        }
+
+        size_ = refined.size();
+    }
+
+    representatives_.assign(size_, 0);
+
+    // Bytes are visited in descending order, so each class is left with its lowest byte.
+    for (std::size_t symbol{alphabet_size}; symbol-- > 0;)
+    {
+        representatives_[classes_[symbol]] = static_cast<Label::Symbol_t>(symbol);
+    }
+}
+
+std::size_t Classes::size() const noexcept
+{
+    return size_;
+}
+
+Label::Symbol_t Classes::representative(const Class_t id) const noexcept
+{
+    return representatives_[id];
+}
+
+} // namespace lexer::dfa
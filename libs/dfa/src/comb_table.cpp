@@ -0,0 +1,88 @@
+#include "lexer/dfa/comb_table.hpp"
+
+#include <utility>
+
+#include "displacement.hpp"
+#include "lexer/dfa/table.hpp"
+
+namespace lexer::dfa
+{
+template <std::unsigned_integral State>
+Comb_table<State>::Comb_table(const Dfa& dfa) : Comb_table{Table{dfa}}
+{}
+
+template <std::unsigned_integral State>
+Comb_table<State>::Comb_table(const Table& table) : Comb_table{pack(table)}
+{}
+
+template <std::unsigned_integral State>
+template <std::same_as<Dfa::State_t> Wide>
+    requires(!std::same_as<State, Wide>)
+Comb_table<State>::Comb_table(const Comb_table<Wide>& table)
+    : Comb_table{static_cast<State_t>(table.init_state_),
+              table.classes_,
+              narrow<State_t>(table.base_),
+              narrow<State_t>(table.next_),
+              narrow<State_t>(table.check_),
+              table.accept_tokens_}
+{}
+
+template <std::unsigned_integral State>
+Comb_table<State>::Comb_table(const State_t init_state,
+        const Classes& classes,
+        std::vector<State_t> base,
+        std::vector<State_t> next,
+        std::vector<State_t> check,
+        std::vector<std::optional<Token>> accept_tokens)
+    : init_state_{init_state}
+    , classes_{classes}
+    , base_{std::move(base)}
+    , next_{std::move(next)}
+    , check_{std::move(check)}
+    , accept_tokens_{std::move(accept_tokens)}
+{}
+
+template <std::unsigned_integral State>
+Comb_table<> Comb_table<State>::pack(const Table& table)
+{
+    // The dense table resolves every (state, class) pair; only the live entries of its rows are packed.
+    const auto& classes{table.classes()};
+
+    const auto width{classes.size()};
+
+    Rows_t rows(table.size());
+
+    std::vector<std::optional<Token>> accept_tokens;
+
+    accept_tokens.reserve(table.size());
+
+    for (Table::State_t state{0}; state < table.size(); ++state)
+    {
+        for (std::size_t id{0}; id < width; ++id)
+        {
+            const auto to{table.next(state, classes.representative(static_cast<Classes::Class_t>(id)))};
+
+            if (to != Table::dead_state)
+            {
+                rows[state].emplace_back(id, to);
+            }
+        }
+
+        accept_tokens.push_back(table.accept_token(state));
+    }
+
+    auto [base, next, check]{displace(rows, width, Comb_table<>::dead_state)};
+
+    return {table.init_state(), classes, std::move(base), std::move(next), std::move(check), std::move(accept_tokens)};
+}
+
+template class Comb_table<std::uint8_t>;
+template class Comb_table<std::uint16_t>;
+template class Comb_table<std::uint32_t>;
+template class Comb_table<Dfa::State_t>;
+
+template Comb_table<std::uint8_t>::Comb_table(const Comb_table<>&);
+template Comb_table<std::uint16_t>::Comb_table(const Comb_table<>&);
+template Comb_table<std::uint32_t>::Comb_table(const Comb_table<>&);
+
+} // namespace lexer::dfa
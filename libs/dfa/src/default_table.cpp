@@ -0,0 +1,219 @@
+#include "lexer/dfa/default_table.hpp"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "displacement.hpp"
+#include "lexer/dfa/table.hpp"
+
+namespace lexer::dfa
+{
+namespace
+{
+/**
+ * @brief The number of most recently placed states sharing a state's most frequent target tried as its default.
+ */
+constexpr std::size_t siblings{8};
+
+} // namespace
+
+template <std::unsigned_integral State>
+Default_table<State>::Default_table(const Dfa& dfa, const std::size_t depth) : Default_table{pack(Table{dfa}, depth)}
+{}
+
+template <std::unsigned_integral State>
+template <std::same_as<Dfa::State_t> Wide>
+    requires(!std::same_as<State, Wide>)
+Default_table<State>::Default_table(const Default_table<Wide>& table)
+    : Default_table{static_cast<State_t>(table.init_state_),
+              table.classes_,
+              table.depth_,
+              narrow<State_t>(table.base_),
+              narrow<State_t>(table.default_),
+              narrow<State_t>(table.next_),
+              narrow<State_t>(table.check_),
+              table.accept_tokens_}
+{}
+
+template <std::unsigned_integral State>
+Default_table<State>::Default_table(const State_t init_state,
+        const Classes& classes,
+        const std::size_t depth,
+        std::vector<State_t> base,
+        std::vector<State_t> defaults,
+        std::vector<State_t> next,
+        std::vector<State_t> check,
+        std::vector<std::optional<Token>> accept_tokens)
+    : init_state_{init_state}
+    , classes_{classes}
+    , depth_{depth}
+    , base_{std::move(base)}
+    , default_{std::move(defaults)}
+    , next_{std::move(next)}
+    , check_{std::move(check)}
+    , accept_tokens_{std::move(accept_tokens)}
+{}
+
+template <std::unsigned_integral State>
+Default_table<> Default_table<State>::pack(const Table& table, const std::size_t depth)
+{
+    using Wide_t = Dfa::State_t;
+
+    constexpr auto dead_state{Default_table<>::dead_state};
+
+    const auto& classes{table.classes()};
+
+    const auto width{classes.size()};
+
+    std::vector<std::vector<Wide_t>> rows(table.size(), std::vector<Wide_t>(width));
+
+    std::vector<std::size_t> live(table.size(), 0);
+
+    for (Wide_t state{0}; state < table.size(); ++state)
+    {
+        for (std::size_t id{0}; id < width; ++id)
+        {
+            rows[state][id] = table.next(state, classes.representative(static_cast<Classes::Class_t>(id)));
+
+            live[state] += rows[state][id] != Table::dead_state;
+        }
+    }
+
+    // Densest rows are placed first, so that sparser rows may default to them; defaults only point to states placed
+    // before, which keeps the chains acyclic.
+    std::vector<Wide_t> order(table.size());
+
+    std::iota(order.begin(), order.end(), Wide_t{0});
+
+    std::ranges::stable_sort(order, std::ranges::greater{}, [&live](const auto state) { return live[state]; });
+
+    std::vector<Wide_t> defaults(table.size(), dead_state);
+
+    std::size_t longest{0};
+
+    std::vector<std::size_t> depths(table.size(), 0);
+
+    std::vector<bool> placed(table.size(), false);
+
+    // States placed so far, by their most frequent target.
+    std::unordered_map<Wide_t, std::vector<Wide_t>> placed_by_target;
+
+    const auto cost{[&rows, width](const Wide_t state, const Wide_t to) {
+        std::size_t cost{0};
+
+        for (std::size_t id{0}; id < width; ++id)
+        {
+            cost += rows[state][id] != rows[to][id];
+        }
+
+        return cost;
+    }};
+
+    for (const auto state : order)
+    {
+        // Near-identical rows share their targets: the candidates are the targets of the state and the last states
+        // placed with the same most frequent target.
+        std::map<Wide_t, std::size_t> targets;
+
+        for (const auto to : rows[state])
+        {
+            if (to != Table::dead_state)
+            {
+                ++targets[to];
+            }
+        }
+
+        std::vector<Wide_t> candidates;
+
+        for (const auto& [to, count] : targets)
+        {
+            candidates.push_back(to);
+        }
+
+        const auto frequent{targets.empty() ? dead_state : std::ranges::max_element(targets, {}, [](const auto& entry) {
+            return entry.second;
+        })->first};
+
+        auto& group{placed_by_target[frequent]};
+
+        candidates.insert(candidates.end(), group.rbegin(), group.rbegin() + std::min(group.size(), siblings));
+
+        auto best{live[state]};
+
+        for (const auto candidate : candidates)
+        {
+            if (candidate == state || !placed[candidate] || depths[candidate] >= depth)
+            {
+                continue;
+            }
+
+            if (const auto candidate_cost{cost(state, candidate)}; candidate_cost < best)
+            {
+                best = candidate_cost;
+
+                defaults[state] = candidate;
+            }
+        }
+
+        if (defaults[state] != dead_state)
+        {
+            depths[state] = depths[defaults[state]] + 1;
+
+            longest = std::max(longest, depths[state]);
+        }
+
+        placed[state] = true;
+
+        group.push_back(state);
+    }
+
+    // Each row keeps the entries differing from its default state, or its live entries if it has none.
+    Rows_t deltas(table.size());
+
+    for (Wide_t state{0}; state < table.size(); ++state)
+    {
+        for (std::size_t id{0}; id < width; ++id)
+        {
+            const auto to{rows[state][id]};
+
+            if (defaults[state] != dead_state ? to != rows[defaults[state]][id] : to != Table::dead_state)
+            {
+                deltas[state].emplace_back(id, to);
+            }
+        }
+    }
+
+    auto [base, next, check]{displace(deltas, width, dead_state)};
+
+    std::vector<std::optional<Token>> accept_tokens;
+
+    accept_tokens.reserve(table.size());
+
+    for (Wide_t state{0}; state < table.size(); ++state)
+    {
+        accept_tokens.push_back(table.accept_token(state));
+    }
+
+    return {table.init_state(),
+            classes,
+            longest,
+            std::move(base),
+            std::move(defaults),
+            std::move(next),
+            std::move(check),
+            std::move(accept_tokens)};
+}
+
+template class Default_table<std::uint8_t>;
+template class Default_table<std::uint16_t>;
+template class Default_table<std::uint32_t>;
+template class Default_table<Dfa::State_t>;
+
+template Default_table<std::uint8_t>::Default_table(const Default_table<>&);
+template Default_table<std::uint16_t>::Default_table(const Default_table<>&);
+template Default_table<std::uint32_t>::Default_table(const Default_table<>&);
+
+} // namespace lexer::dfa
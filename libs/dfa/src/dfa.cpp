@@ -2,28 +2,75 @@
 
 #include <algorithm>
 #include <boost/container_hash/hash.hpp>
+#include <numeric>
 #include <ranges>
 
 namespace lexer::dfa
 {
-std::size_t Dfa::Hash::operator()(const Key_t& key) const noexcept
+std::size_t Dfa::Map_hash::operator()(const Map_key_t& key) const noexcept
 {
     std::size_t seed{};
     return boost::hash_combine(seed, key.first), boost::hash_combine(seed, std::hash<Label>{}(key.second)), seed;
 }
 
-Dfa::Dfa(const State_t init_state, Transitions_t transitions, Accept_states_t accept_states)
-    : init_state_{init_state}, transitions_{std::move(transitions)}, accept_states_{std::move(accept_states)}
-{}
+Dfa::Dfa(const State_t init_state, const Map_transitions_t& transitions, Accept_states_t accept_states)
+    : init_state_{init_state}, accept_states_{std::move(accept_states)}
+{
+    auto size{init_state_ + 1};
+
+    for (const auto& [key, to] : transitions)
+    {
+        size = std::max({size, key.first + 1, to + 1});
+    }
+
+    for (const auto state : std::views::keys(accept_states_))
+    {
+        size = std::max(size, state + 1);
+    }
+
+    edge_offsets_.assign(size + 1, 0);
+
+    // Count the edges of each state, turn the counts into offsets, then fill each row from its end.
+    std::ranges::for_each(std::views::keys(transitions), [this](const auto& key) { ++edge_offsets_[key.first + 1]; });
+
+    std::partial_sum(edge_offsets_.begin(), edge_offsets_.end(), edge_offsets_.begin());
+
+    edges_.resize(edge_offsets_.back(), Edge{Label{'\0'}, 0});
+
+    auto edge_ends{std::vector(edge_offsets_.begin() + 1, edge_offsets_.end())};
+
+    for (const auto& [key, to] : transitions)
+    {
+        edges_[--edge_ends[key.first]] = {key.second, to};
+    }
+
+    const auto order{[](const Edge& edge) { return edge.label.first(); }};
+
+    for (State_t state{0}; state < size; ++state)
+    {
+        std::ranges::sort(
+                edges_.begin() + static_cast<std::ptrdiff_t>(edge_offsets_[state]),
+                edges_.begin() + static_cast<std::ptrdiff_t>(edge_offsets_[state + 1]), {}, order);
+    }
+}
 
 Dfa::State_t Dfa::init_state() const noexcept
 {
     return init_state_;
 }
 
-const Dfa::Transitions_t& Dfa::transitions() const noexcept
+Dfa::Map_transitions_t Dfa::transitions() const
 {
-    return transitions_;
+    Map_transitions_t transitions;
+
+    for (State_t state{0}; state < size(); ++state)
+    {
+        std::ranges::for_each(edges(state), [&transitions, state](const Edge& edge) {
+            transitions.emplace(Map_key_t{state, edge.label}, edge.to);
+        });
+    }
+
+    return transitions;
 }
 
 const Dfa::Accept_states_t& Dfa::accept_states() const noexcept
@@ -31,16 +78,42 @@ const Dfa::Accept_states_t& Dfa::accept_states() const noexcept
     return accept_states_;
 }
 
-std::optional<Dfa::State_t> Dfa::advance(const Dfa& dfa, const State_t state, const char symbol)
+std::size_t Dfa::size() const noexcept
+{
+    return edge_offsets_.size() - 1;
+}
+
+std::span<const Dfa::Edge> Dfa::edges(const State_t state) const noexcept
+{
+    return std::span{edges_}.subspan(edge_offsets_[state], edge_offsets_[state + 1] - edge_offsets_[state]);
+}
+
+std::optional<Dfa::State_t> Dfa::advance(const Dfa& dfa, const State_t state, const Label::Symbol_t symbol)
 {
-    const std::pair key{state, Label{symbol}};
+    if (state >= dfa.size())
+    {
+        return std::nullopt;
+    }
+
+    const auto edges{dfa.edges(state)};
 
-    return dfa.transitions().contains(key) ? std::optional{dfa.transitions().at(key)} : std::nullopt;
+    // Find the last edge whose range starts at or below the symbol; it is the only candidate.
+    const auto iterator{
+            std::ranges::upper_bound(edges, symbol, {}, [](const Edge& edge) { return edge.label.first(); })};
+
+    if (iterator == edges.begin() || !std::prev(iterator)->label.contains(symbol))
+    {
+        return std::nullopt;
+    }
+
+    return std::prev(iterator)->to;
 }
 
 std::optional<Token> Dfa::has_accept_token(const Dfa& dfa, const State_t state)
 {
-    return dfa.accept_states().contains(state) ? std::optional{dfa.accept_states().at(state)} : std::nullopt;
+    const auto iterator{dfa.accept_states().find(state)};
+
+    return iterator != dfa.accept_states().end() ? std::optional{iterator->second} : std::nullopt;
 }
 
 } // namespace lexer::dfa
@@ -0,0 +1,93 @@
+#include "displacement.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+namespace lexer::dfa
+{
+Displacement displace(const Rows_t& rows, const std::size_t width, const Dfa::State_t empty)
+{
+    // Densest rows first, each at the lowest offset where its entries only land on free slots (first fit).
+    std::vector<Dfa::State_t> order(rows.size());
+
+    std::iota(order.begin(), order.end(), Dfa::State_t{0});
+
+    std::ranges::stable_sort(order, std::ranges::greater{}, [&rows](const auto state) { return rows[state].size(); });
+
+    Displacement result;
+
+    result.base.assign(rows.size(), 0);
+
+    // Slots below `end` are either used or holes; every slot from `end` on is free.
+    std::set<std::size_t> holes;
+
+    std::size_t end{0};
+
+    std::vector<bool> used;
+
+    for (const auto state : order)
+    {
+        const auto& row{rows[state]};
+
+        if (row.empty())
+        {
+            continue;
+        }
+
+        const auto first{row.front().first};
+
+        const auto fits{[&row, &used](const std::size_t base) {
+            return std::ranges::none_of(row, [&used, base](const auto& entry) {
+                return base + entry.first < used.size() && used[base + entry.first];
+            });
+        }};
+
+        // Only the offsets placing the first entry into a hole are tried before appending the row past the end.
+        const auto hole{std::ranges::find_if(holes.lower_bound(first), holes.end(), [&fits, first](const auto slot) {
+            return fits(slot - first);
+        })};
+
+        const auto base{hole != holes.end() ? *hole - first : std::max(end, first) - first};
+
+        for (auto slot{end}; slot < base + row.back().first; ++slot)
+        {
+            holes.insert(slot);
+        }
+
+        end = std::max(end, base + row.back().first + 1);
+
+        used.resize(end, false);
+
+        for (const auto& entry : row)
+        {
+            used[base + entry.first] = true;
+
+            holes.erase(base + entry.first);
+        }
+
+        result.base[state] = base;
+    }
+
+    // Every row reads at most `width` slots past its base, so the arrays are padded to keep all lookups in bounds.
+    const auto size{std::ranges::fold_left(result.base, std::size_t{0}, [](const auto size, const auto base) {
+        return std::max(size, base);
+    }) + width};
+
+    result.next.assign(size, empty);
+
+    result.check.assign(size, empty);
+
+    for (Dfa::State_t state{0}; state < rows.size(); ++state)
+    {
+        for (const auto& [id, to] : rows[state])
+        {
+            result.next[result.base[state] + id] = to;
+            result.check[result.base[state] + id] = state;
+        }
+    }
+
+    return result;
+}
+
+} // namespace lexer::dfa
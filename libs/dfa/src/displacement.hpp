@@ -0,0 +1,85 @@
+#ifndef LEXER_LIBS_DFA_SRC_DISPLACEMENT_HPP
+#define LEXER_LIBS_DFA_SRC_DISPLACEMENT_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lexer/dfa/dfa.hpp"
+
+namespace lexer::dfa
+{
+/**
+ * @brief Sparse rows of a transition table, listing the `(class, target)` entries of each state by ascending class.
+ */
+using Rows_t = std::vector<std::vector<std::pair<std::size_t, Dfa::State_t>>>;
+
+/**
+ * @brief Rows overlapped into shared comb vectors.
+ */
+struct Displacement
+{
+    /**
+     * @brief The offset of each row within the next and check arrays.
+     */
+    std::vector<std::size_t> base;
+
+    /**
+     * @brief The target of each used slot.
+     */
+    std::vector<Dfa::State_t> next;
+
+    /**
+     * @brief The state owning each used slot, `empty` for free slots.
+     */
+    std::vector<Dfa::State_t> check;
+};
+
+/**
+ * @brief Overlaps sparse rows by first-fit row displacement, densest rows first.
+ * @param rows The rows to pack.
+ * @param width The number of classes, bounding the class of every entry.
+ * @param empty The state marking the free slots of the check array and the next array.
+ * @return The packed rows, padded so that any row can be read `width` slots past its base.
+ */
+[[nodiscard]] Displacement displace(const Rows_t& rows, std::size_t width, Dfa::State_t empty);
+
+/**
+ * @brief Copies the states or slots of packed rows into a narrower unsigned type.
+ *
+ * The largest wide value, which marks dead states and free slots, becomes the largest narrow value.
+ *
+ * @tparam Entry The unsigned type of the narrow entries.
+ * @param entries The wide entries.
+ * @return The narrow entries.
+ * @throws std::length_error if some other entry does not fit below the largest narrow value.
+ */
+template <std::unsigned_integral Entry>
+[[nodiscard]] std::vector<Entry> narrow(const std::vector<Dfa::State_t>& entries)
+{
+    constexpr auto wide_empty{std::numeric_limits<Dfa::State_t>::max()};
+    constexpr auto narrow_empty{std::numeric_limits<Entry>::max()};
+
+    std::vector<Entry> result;
+
+    result.reserve(entries.size());
+
+    std::ranges::transform(entries, std::back_inserter(result), [](const auto entry) {
+        if (entry != wide_empty && entry >= narrow_empty)
+        {
+            throw std::length_error("Packed rows do not fit the narrow entry type");
+        }
+
+        return entry == wide_empty ? narrow_empty : static_cast<Entry>(entry);
+    });
+
+    return result;
+}
+
+} // namespace lexer::dfa
+
+#endif // LEXER_LIBS_DFA_SRC_DISPLACEMENT_HPP
@@ -1,18 +1,43 @@
 #include "lexer/dfa/label.hpp"
 
+#include <stdexcept>
+
 namespace lexer::dfa
 {
-Label::Label(const Symbol_t s) noexcept : symbol_{s}
+Label::Label(const Symbol_t s) noexcept : first_{s}, last_{s}
 {}
 
+Label::Label(const Symbol_t first, const Symbol_t last) : first_{first}, last_{last}
+{
+    if (first > last)
+    {
+        throw std::invalid_argument("Label range first symbol is greater than its last symbol");
+    }
+}
+
+Label::Symbol_t Label::first() const noexcept
+{
+    return first_;
+}
+
+Label::Symbol_t Label::last() const noexcept
+{
+    return last_;
+}
+
 Label::Symbol_t Label::symbol() const noexcept
 {
-    return symbol_;
+    return first_;
+}
+
+bool Label::contains(const Symbol_t symbol) const noexcept
+{
+    return first_ <= symbol && symbol <= last_;
 }
 
 bool Label::operator==(const Label& other) const noexcept
 {
-    return symbol_ == other.symbol_;
+    return first_ == other.first_ && last_ == other.last_;
 }
 
 } // namespace lexer::dfa
@@ -0,0 +1,43 @@
+#include "lexer/dfa/memo.hpp"
+
+#include <algorithm>
+
+namespace lexer::dfa
+{
+Memo::Memo(const std::size_t states, const std::size_t length, const std::size_t capacity)
+    : states_{states}
+    , window_{std::clamp(capacity / std::max<std::size_t>(states, 1), std::size_t{1}, length + 1)}
+    , base_{0}
+    , failed_(window_ * states)
+{}
+
+void Memo::seek(const std::size_t position)
+{
+    if (position < base_)
+    {
+        failed_.assign(failed_.size(), false);
+    }
+    else
+    {
+        // Clear the rows of the positions left behind, which the window reuses for the positions ahead.
+        for (auto row{base_}; row < std::min(position, base_ + window_); ++row)
+        {
+            const auto first{failed_.begin() + static_cast<std::ptrdiff_t>((row % window_) * states_)};
+
+            std::fill(first, first + static_cast<std::ptrdiff_t>(states_), false);
+        }
+    }
+
+    base_ = position;
+}
+
+void Memo::fail()
+{
+    std::ranges::for_each(visited_, [this](const auto& pair) {
+        failed_[(pair.second % window_) * states_ + pair.first] = true;
+    });
+
+    visited_.clear();
+}
+
+} // namespace lexer::dfa
@@ -0,0 +1,358 @@
+#include "lexer/dfa/minimize.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/classes.hpp"
+
+namespace
+{
+using State_t = lexer::dfa::Dfa::State_t;
+
+/**
+ * Refinable partition of the dense states `[0, size)`. Blocks occupy contiguous ranges of `elements_`, the marked
+ * members of a block being moved to the front of its range while a splitter is processed.
+ */
+class Partition
+{
+public:
+    explicit Partition(const std::vector<std::size_t>& initial_blocks)
+        : elements_(initial_blocks.size()), location_(initial_blocks.size()), block_of_(initial_blocks.size())
+    {
+        const auto blocks{std::ranges::max(initial_blocks) + 1};
+
+        std::vector<std::size_t> sizes(blocks);
+
+        std::ranges::for_each(initial_blocks, [&sizes](const auto block) { ++sizes[block]; });
+
+        for (std::size_t block{0}, first{0}; block < blocks; first += sizes[block++])
+        {
+            first_.push_back(first);
+            end_.push_back(first);
+            marked_.push_back(0);
+        }
+
+        for (std::size_t state{0}; state < initial_blocks.size(); ++state)
+        {
+            const auto block{initial_blocks[state]};
+
+            location_[state] = end_[block];
+            elements_[end_[block]++] = state;
+            block_of_[state] = block;
+        }
+    }
+
+    [[nodiscard]] std::size_t blocks() const noexcept { return first_.size(); }
+
+    [[nodiscard]] std::size_t block_of(const std::size_t state) const noexcept { return block_of_[state]; }
+
+    [[nodiscard]] std::size_t size(const std::size_t block) const noexcept { return end_[block] - first_[block]; }
+
+    [[nodiscard]] auto members(const std::size_t block) const
+    {
+        return std::ranges::subrange(elements_.begin() + first_[block], elements_.begin() + end_[block]);
+    }
+
+    /**
+     * Marks a state, returning true if it is the first marked member of its block.
+     */
+    bool mark(const std::size_t state)
+    {
+        const auto block{block_of_[state]};
+
+        const auto boundary{first_[block] + marked_[block]};
+
+        if (location_[state] < boundary)
+        {
+            return false;
+        }
+
+        const auto other{elements_[boundary]};
+
+        std::swap(elements_[location_[state]], elements_[boundary]);
+        std::swap(location_[state], location_[other]);
+
+        return marked_[block]++ == 0;
+    }
+
+    /**
+     * Splits the marked members off a block, returning the new block if both halves are non-empty.
+     */
+    std::optional<std::size_t> split(const std::size_t block)
+    {
+        const auto marked{std::exchange(marked_[block], 0)};
+
+        if (marked == size(block))
+        {
+            return std::nullopt;
+        }
+
+        const auto split_block{blocks()};
+
+        first_.push_back(first_[block]);
+        end_.push_back(first_[block] + marked);
+        marked_.push_back(0);
+
+        first_[block] += marked;
+
+        std::ranges::for_each(members(split_block), [this, split_block](const auto state) {
+            block_of_[state] = split_block;
+        });
+
+        return split_block;
+    }
+
+private:
+    std::vector<std::size_t> elements_;
+
+    std::vector<std::size_t> location_;
+
+    std::vector<std::size_t> block_of_;
+
+    std::vector<std::size_t> first_;
+
+    std::vector<std::size_t> end_;
+
+    std::vector<std::size_t> marked_;
+};
+
+} // namespace
+
+namespace lexer::dfa
+{
+Dfa minimize(const Dfa& dfa)
+{
+    // Map state identifiers to dense indices, the extra last state being the implicit dead state. Byte classes serve as
+    // the alphabet, since overlapping range labels of different states are not comparable as symbols.
+    std::unordered_map<State_t, std::size_t> index{{dfa.init_state(), 0}};
+
+    std::vector<State_t> original{dfa.init_state()};
+
+    const auto add_state{[&index, &original](const auto state) {
+        if (index.emplace(state, index.size()).second)
+        {
+            original.push_back(state);
+        }
+    }};
+
+    for (State_t state{0}; state < dfa.size(); ++state)
+    {
+        for (const auto& edge : dfa.edges(state))
+        {
+            add_state(state);
+            add_state(edge.to);
+        }
+    }
+
+    std::ranges::for_each(std::views::keys(dfa.accept_states()), add_state);
+
+    const Classes classes{dfa};
+
+    const auto dead{index.size()};
+
+    const auto states{dead + 1};
+
+    const auto arity{classes.size()};
+
+    std::vector delta(states * arity, dead);
+
+    for (State_t state{0}; state < dfa.size(); ++state)
+    {
+        for (const auto& [label, to] : dfa.edges(state))
+        {
+            for (unsigned symbol{label.first()}; symbol <= label.last(); ++symbol)
+            {
+                delta[index.at(state) * arity + classes[static_cast<Label::Symbol_t>(symbol)]] = index.at(to);
+            }
+        }
+    }
+
+    std::vector<std::optional<Token>> tokens(states);
+
+    for (const auto& [state, token] : dfa.accept_states())
+    {
+        tokens[index.at(state)] = token;
+    }
+
+    // Inverse transitions in compressed rows: predecessors of state q on symbol c are
+    // `predecessors[offsets[c * states + q], offsets[c * states + q + 1])`.
+    std::vector<std::size_t> offsets(states * arity + 1);
+
+    for (std::size_t state{0}; state < states; ++state)
+    {
+        for (std::size_t symbol{0}; symbol < arity; ++symbol)
+        {
+            ++offsets[symbol * states + delta[state * arity + symbol] + 1];
+        }
+    }
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::size_t> predecessors(offsets.back());
+
+    auto fill{offsets};
+
+    for (std::size_t state{0}; state < states; ++state)
+    {
+        for (std::size_t symbol{0}; symbol < arity; ++symbol)
+        {
+            predecessors[fill[symbol * states + delta[state * arity + symbol]]++] = state;
+        }
+    }
+
+    // Initial partition: non-accepting states (including the dead state), then one block per accepted token id.
+    std::map<std::optional<std::size_t>, std::size_t> token_blocks{{std::nullopt, 0}};
+
+    std::vector<std::size_t> initial_blocks;
+
+    std::ranges::transform(tokens, std::back_inserter(initial_blocks), [&token_blocks](const auto& token) {
+        const auto id{token ? std::optional{token->id()} : std::nullopt};
+        return token_blocks.emplace(id, token_blocks.size()).first->second;
+    });
+
+    Partition partition{initial_blocks};
+
+    std::vector<bool> pending;
+
+    std::queue<std::pair<std::size_t, std::size_t>> worklist;
+
+    const auto push{[&pending, &worklist, arity](const auto block, const auto symbol) {
+        if (pending.size() < (block + 1) * arity)
+        {
+            pending.resize((block + 1) * arity);
+        }
+
+        if (!pending[block * arity + symbol])
+        {
+            pending[block * arity + symbol] = true;
+            worklist.emplace(block, symbol);
+        }
+    }};
+
+    // Every initial block but the largest one is a splitter.
+    const auto largest{std::ranges::max(
+            std::views::iota(static_cast<std::size_t>(0), partition.blocks()), {},
+            [&partition](const auto block) { return partition.size(block); })};
+
+    for (std::size_t block{0}; block < partition.blocks(); ++block)
+    {
+        for (std::size_t symbol{0}; block != largest && symbol < arity; ++symbol)
+        {
+            push(block, symbol);
+        }
+    }
+
+    std::vector<std::size_t> splitter;
+
+    std::vector<std::size_t> touched;
+
+    while (!worklist.empty())
+    {
+        const auto [block, symbol]{worklist.front()};
+
+        worklist.pop();
+
+        pending[block * arity + symbol] = false;
+
+        splitter.assign(partition.members(block).begin(), partition.members(block).end());
+
+        for (const auto state : splitter)
+        {
+            const auto first{predecessors.begin() + offsets[symbol * states + state]};
+
+            const auto last{predecessors.begin() + offsets[symbol * states + state + 1]};
+
+            std::ranges::for_each(first, last, [&partition, &touched](const auto predecessor) {
+                if (partition.mark(predecessor))
+                {
+                    touched.push_back(partition.block_of(predecessor));
+                }
+            });
+        }
+
+        for (const auto touched_block : touched)
+        {
+            const auto split_block{partition.split(touched_block)};
+
+            if (!split_block)
+            {
+                continue;
+            }
+
+            for (std::size_t other{0}; other < arity; ++other)
+            {
+                const auto both{
+                        pending.size() > touched_block * arity + other && pending[touched_block * arity + other]};
+
+                const auto smaller{
+                        partition.size(*split_block) <= partition.size(touched_block) ? *split_block : touched_block};
+
+                push(both ? *split_block : smaller, other);
+            }
+        }
+
+        touched.clear();
+    }
+
+    // Emit one state per block reachable from the initial block, dropping the block of the dead state.
+    const auto dead_block{partition.block_of(dead)};
+
+    Builder builder;
+
+    std::unordered_map<std::size_t, State_t> block_states{{partition.block_of(0), builder.init_state()}};
+
+    std::queue<std::size_t> queue{{partition.block_of(0)}};
+
+    while (!queue.empty())
+    {
+        const auto block{queue.front()};
+
+        queue.pop();
+
+        const auto from{block_states.at(block)};
+
+        const auto representative{partition.members(block).front()};
+
+        if (const auto& token = tokens[representative]; token)
+        {
+            builder.add_accept_state(from, *token);
+        }
+
+        if (block == dead_block)
+        {
+            continue;
+        }
+
+        // All members of a block are equivalent, so the representative's own labels describe the merged state.
+        for (const auto& [label, to] : dfa.edges(original[representative]))
+        {
+            const auto to_block{partition.block_of(index.at(to))};
+
+            if (to_block == dead_block)
+            {
+                continue;
+            }
+
+            if (const auto [iterator, inserted] = block_states.emplace(to_block, 0); inserted)
+            {
+                iterator->second = builder.next_state();
+                queue.push(to_block);
+            }
+
+            builder.add_transition(from, label, block_states.at(to_block));
+        }
+    }
+
+    return builder.build();
+}
+
+} // namespace lexer::dfa
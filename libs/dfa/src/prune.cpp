@@ -0,0 +1,97 @@
+#include "lexer/dfa/prune.hpp"
+
+#include <queue>
+#include <ranges>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "lexer/dfa/builder.hpp"
+
+namespace lexer::dfa
+{
+Dfa prune(const Dfa& dfa)
+{
+    using State_t = Dfa::State_t;
+
+    // Productive states are found backwards from the accepting states.
+    std::unordered_map<State_t, std::vector<State_t>> predecessors;
+
+    for (State_t state{0}; state < dfa.size(); ++state)
+    {
+        for (const auto& edge : dfa.edges(state))
+        {
+            predecessors[edge.to].push_back(state);
+        }
+    }
+
+    std::unordered_set<State_t> productive;
+
+    std::queue<State_t> queue;
+
+    for (const auto state : std::views::keys(dfa.accept_states()))
+    {
+        productive.insert(state);
+        queue.push(state);
+    }
+
+    while (!queue.empty())
+    {
+        const auto state{queue.front()};
+
+        queue.pop();
+
+        if (const auto iterator = predecessors.find(state); iterator != predecessors.end())
+        {
+            for (const auto predecessor : iterator->second)
+            {
+                if (productive.insert(predecessor).second)
+                {
+                    queue.push(predecessor);
+                }
+            }
+        }
+    }
+
+    // Reachable states are then emitted forwards from the initial state, only following transitions that stay
+    // productive.
+    Builder builder;
+
+    std::unordered_map<State_t, State_t> states{{dfa.init_state(), builder.init_state()}};
+
+    queue.push(dfa.init_state());
+
+    while (!queue.empty())
+    {
+        const auto state{queue.front()};
+
+        queue.pop();
+
+        const auto from{states.at(state)};
+
+        if (const auto token = Dfa::has_accept_token(dfa, state); token)
+        {
+            builder.add_accept_state(from, *token);
+        }
+
+        for (const auto& [label, to] : dfa.edges(state))
+        {
+            if (!productive.contains(to))
+            {
+                continue;
+            }
+
+            if (const auto [iterator, inserted] = states.emplace(to, 0); inserted)
+            {
+                iterator->second = builder.next_state();
+                queue.push(to);
+            }
+
+            builder.add_transition(from, label, states.at(to));
+        }
+    }
+
+    return builder.build();
+}
+
+} // namespace lexer::dfa
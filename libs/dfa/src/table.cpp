@@ -0,0 +1,54 @@
+#include "lexer/dfa/table.hpp"
+
+#include <algorithm>
+
+namespace lexer::dfa
+{
+Table::Table(const Dfa& dfa) : init_state_{dfa.init_state()}, classes_{dfa}
+{
+    // State identifiers handed out by the builder are dense, so the largest referenced one bounds the row count.
+    const auto size{dfa.size()};
+
+    transitions_.assign(size * classes_.size(), dead_state);
+
+    accept_tokens_.assign(size, std::nullopt);
+
+    for (State_t from{0}; from < size; ++from)
+    {
+        for (const auto& [label, to] : dfa.edges(from))
+        {
+            // Every byte of the range maps to a class lying wholly inside it, so marking each byte's class is exact.
+            for (unsigned symbol{label.first()}; symbol <= label.last(); ++symbol)
+            {
+                transitions_[from * classes_.size() + classes_[static_cast<Label::Symbol_t>(symbol)]] = to;
+            }
+        }
+    }
+
+    for (const auto& [state, token] : dfa.accept_states())
+    {
+        accept_tokens_[state] = token;
+    }
+}
+
+Table::State_t Table::init_state() const noexcept
+{
+    return init_state_;
+}
+
+std::size_t Table::size() const noexcept
+{
+    return accept_tokens_.size();
+}
+
+std::size_t Table::bytes() const noexcept
+{
+    return transitions_.size() * sizeof(State_t);
+}
+
+const Classes& Table::classes() const noexcept
+{
+    return classes_;
+}
+
+} // namespace lexer::dfa
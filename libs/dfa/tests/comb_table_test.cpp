@@ -0,0 +1,210 @@
+#include "lexer/dfa/comb_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <string>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/narrow_table.hpp"
+#include "lexer/dfa/simulator.hpp"
+#include "lexer/dfa/table.hpp"
+
+using namespace lexer;
+using namespace lexer::dfa;
+
+using Comb_table_test = testing::Test;
+
+TEST_F(Comb_table_test, Test_empty)
+{
+    const dfa::Builder dfa;
+
+    const Comb_table table{dfa.build()};
+
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.init_state(), dfa.init_state());
+    EXPECT_EQ(table.next(table.init_state(), 'a'), Comb_table<>::dead_state);
+    EXPECT_EQ(table.accept_token(table.init_state()), std::nullopt);
+}
+
+TEST_F(Comb_table_test, Matches_dense_table)
+{
+    dfa::Builder dfa;
+
+    // Identifiers, the keyword "if" and decimal integers.
+    const auto q0{dfa.init_state()};
+    const auto i{dfa.next_state()};
+    const auto f{dfa.next_state()};
+    const auto identifier{dfa.next_state()};
+    const auto integer{dfa.next_state()};
+
+    dfa.add_accept_state(i, Token{1});
+    dfa.add_accept_state(f, Token{2});
+    dfa.add_accept_state(identifier, Token{1});
+    dfa.add_accept_state(integer, Token{3});
+
+    dfa.add_transition(q0, dfa::Label('a', 'h'), identifier);
+    dfa.add_transition(q0, dfa::Label('i'), i);
+    dfa.add_transition(q0, dfa::Label('j', 'z'), identifier);
+    dfa.add_transition(q0, dfa::Label('0', '9'), integer);
+    dfa.add_transition(i, dfa::Label('a', 'e'), identifier);
+    dfa.add_transition(i, dfa::Label('f'), f);
+    dfa.add_transition(i, dfa::Label('g', 'z'), identifier);
+
+    for (const auto state : {i, f, identifier})
+    {
+        dfa.add_transition(state, dfa::Label('0', '9'), identifier);
+    }
+
+    for (const auto state : {f, identifier})
+    {
+        dfa.add_transition(state, dfa::Label('a', 'z'), identifier);
+    }
+
+    dfa.add_transition(integer, dfa::Label('0', '9'), integer);
+
+    const auto result{dfa.build()};
+
+    const Table dense{result};
+    const Comb_table comb{result};
+
+    EXPECT_EQ(comb.size(), dense.size());
+
+    for (Comb_table<>::State_t state{0}; state < comb.size(); ++state)
+    {
+        EXPECT_EQ(comb.accept_token(state), dense.accept_token(state));
+
+        for (unsigned symbol{0}; symbol < Classes::alphabet_size; ++symbol)
+        {
+            EXPECT_EQ(comb.next(state, static_cast<Label::Symbol_t>(symbol)),
+                    dense.next(state, static_cast<Label::Symbol_t>(symbol)));
+        }
+    }
+
+    for (const std::string input : {"", "i", "if", "ifx", "x1", "42", "4x", "-"})
+    {
+        EXPECT_EQ(Simulator::run(comb, input), Simulator::run(result, input)) << input;
+
+        const std::list<char> list(input.begin(), input.end());
+
+        EXPECT_EQ(Simulator::run(comb, list), Simulator::run(result, input)) << input;
+    }
+}
+
+TEST_F(Comb_table_test, Overlap_sparse_rows)
+{
+    dfa::Builder dfa;
+
+    // A chain of states, each with a single transition on its own byte: the rows fit into each other's gaps.
+    auto from{dfa.init_state()};
+
+    const std::string word{"abcdefgh"};
+
+    for (const auto symbol : word)
+    {
+        const auto to{dfa.next_state()};
+
+        dfa.add_transition(from, dfa::Label(symbol), to);
+
+        from = to;
+    }
+
+    dfa.add_accept_state(from, Token{1});
+
+    const auto result{dfa.build()};
+
+    const Table dense{result};
+    const Comb_table comb{result};
+
+    EXPECT_LT(comb.bytes(), dense.bytes());
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(comb, word), Result_t(Token{1}, word.size()));
+    EXPECT_EQ(Simulator::run(comb, std::string{"abcdefgx"}), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Comb_table_test, Smaller_than_dense_for_sparse_rows)
+{
+    dfa::Builder dfa;
+
+    // Keywords without an identifier fallback: every state has a transition on a single class.
+    for (const std::string keyword : {"break", "case", "char", "const", "continue", "default", "double", "while"})
+    {
+        auto from{dfa.init_state()};
+
+        for (const auto symbol : keyword.substr(0, keyword.size() - 1))
+        {
+            const auto to{dfa.next_state()};
+
+            dfa.add_transition(from, dfa::Label(symbol), to);
+
+            from = to;
+        }
+
+        const auto to{dfa.next_state()};
+
+        dfa.add_transition(from, dfa::Label(keyword.back()), to);
+        dfa.add_accept_state(to, Token{1});
+    }
+
+    const auto result{dfa.build()};
+
+    const Comb_table wide{result};
+
+    ASSERT_TRUE(Comb_table<std::uint8_t>::fits(wide));
+
+    const Comb_table<std::uint8_t> comb{wide};
+
+    // The dense layout takes the narrowest identifiers that fit as well.
+    const Table table{result};
+
+    const auto dense{Narrow_table<std::uint8_t>::fits(table) ? Narrow_table<std::uint8_t>{table}.bytes()
+                                                               : Narrow_table<std::uint16_t>{table}.bytes()};
+
+    EXPECT_LT(comb.bytes(), dense);
+    EXPECT_LT(wide.bytes(), table.bytes());
+}
+
+TEST_F(Comb_table_test, Narrow_entries)
+{
+    dfa::Builder dfa;
+
+    // A chain of 300 states on 'a', which needs 16-bit state identifiers.
+    auto from{dfa.init_state()};
+
+    for (std::size_t i{0}; i < 300; ++i)
+    {
+        const auto to{dfa.next_state()};
+
+        dfa.add_transition(from, dfa::Label('a'), to);
+
+        from = to;
+    }
+
+    dfa.add_accept_state(from, Token{1});
+
+    const auto result{dfa.build()};
+
+    const Comb_table wide{result};
+
+    EXPECT_FALSE(Comb_table<std::uint8_t>::fits(wide));
+    EXPECT_THROW(Comb_table<std::uint8_t>{wide}, std::length_error);
+    EXPECT_THROW(Comb_table<std::uint8_t>{result}, std::length_error);
+
+    ASSERT_TRUE(Comb_table<std::uint16_t>::fits(wide));
+
+    const Comb_table<std::uint16_t> comb{wide};
+
+    EXPECT_EQ(comb.size(), wide.size());
+    EXPECT_EQ(comb.bytes() * sizeof(Comb_table<>::State_t), wide.bytes() * sizeof(std::uint16_t));
+
+    for (const std::size_t length : {0, 299, 300, 301})
+    {
+        const std::string input(length, 'a');
+
+        EXPECT_EQ(Simulator::run(comb, input), Simulator::run(result, input)) << length;
+    }
+}
@@ -0,0 +1,197 @@
+#include "lexer/dfa/default_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <string>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/comb_table.hpp"
+#include "lexer/dfa/simulator.hpp"
+#include "lexer/dfa/table.hpp"
+
+using namespace lexer;
+using namespace lexer::dfa;
+
+class Default_table_test : public testing::Test
+{
+protected:
+    // Builds a DFA for identifiers over [a-z0-9] and keywords, each keyword prefix differing from an identifier on one
+    // letter.
+    static Dfa keywords(std::initializer_list<std::string> words)
+    {
+        dfa::Builder dfa;
+
+        const auto identifier{dfa.next_state()};
+
+        dfa.add_accept_state(identifier, Token{1});
+        dfa.add_transition(identifier, dfa::Label('a', 'z'), identifier);
+        dfa.add_transition(identifier, dfa::Label('0', '9'), identifier);
+
+        // The states of the keyword prefixes, the empty prefix being the initial state.
+        std::map<std::string, Dfa::State_t> prefixes{{"", dfa.init_state()}};
+
+        for (const auto& word : words)
+        {
+            for (std::size_t length{1}; length <= word.size(); ++length)
+            {
+                if (!prefixes.contains(word.substr(0, length)))
+                {
+                    prefixes.emplace(word.substr(0, length), dfa.next_state());
+                }
+            }
+        }
+
+        for (const auto& [prefix, from] : prefixes)
+        {
+            for (unsigned symbol{'a'}; symbol <= 'z'; ++symbol)
+            {
+                const auto next{prefixes.find(prefix + static_cast<char>(symbol))};
+
+                dfa.add_transition(from, dfa::Label(static_cast<char>(symbol)),
+                        next != prefixes.end() ? next->second : identifier);
+            }
+
+            if (!prefix.empty())
+            {
+                // Keywords take the ids from 2 on, the other prefixes are identifiers.
+                const auto word{std::ranges::find(words, prefix)};
+
+                const auto index{static_cast<std::size_t>(std::distance(words.begin(), word))};
+
+                dfa.add_accept_state(from, Token{word != words.end() ? index + 2 : 1});
+                dfa.add_transition(from, dfa::Label('0', '9'), identifier);
+            }
+        }
+
+        return dfa.build();
+    }
+
+    // Checks that a compiled DFA makes the same transitions as the dense table.
+    template <std::unsigned_integral State>
+    static void expect_equivalent(const Default_table<State>& table, const Table& dense)
+    {
+        ASSERT_EQ(table.size(), dense.size());
+
+        for (State state{0}; state < table.size(); ++state)
+        {
+            EXPECT_EQ(table.accept_token(state), dense.accept_token(state));
+
+            for (unsigned symbol{0}; symbol < Classes::alphabet_size; ++symbol)
+            {
+                const auto to{table.next(state, static_cast<Label::Symbol_t>(symbol))};
+
+                EXPECT_EQ(to == Default_table<State>::dead_state ? Table::dead_state : Table::State_t{to},
+                        dense.next(state, static_cast<Label::Symbol_t>(symbol)));
+            }
+        }
+    }
+};
+
+TEST_F(Default_table_test, Test_empty)
+{
+    const dfa::Builder dfa;
+
+    const Default_table table{dfa.build()};
+
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.depth(), 0);
+    EXPECT_EQ(table.init_state(), dfa.init_state());
+    EXPECT_EQ(table.next(table.init_state(), 'a'), Default_table<>::dead_state);
+    EXPECT_EQ(table.accept_token(table.init_state()), std::nullopt);
+}
+
+TEST_F(Default_table_test, Matches_dense_table)
+{
+    const auto dfa{keywords({"if", "int", "for", "while"})};
+
+    const Table dense{dfa};
+
+    for (const std::size_t depth : {0, 1, 2, 4})
+    {
+        const Default_table table{dfa, depth};
+
+        EXPECT_LE(table.depth(), depth);
+
+        expect_equivalent(table, dense);
+
+        for (const std::string input : {"", "i", "if", "ifx", "in", "int", "int0", "whil", "while", "x1", "4", "-"})
+        {
+            EXPECT_EQ(Simulator::run(table, input), Simulator::run(dfa, input)) << input;
+
+            const std::list<char> list(input.begin(), input.end());
+
+            EXPECT_EQ(Simulator::run(table, list), Simulator::run(dfa, input)) << input;
+        }
+    }
+}
+
+TEST_F(Default_table_test, Store_differences_only)
+{
+    const auto dfa{keywords({"break", "case", "continue", "default", "return", "switch", "typedef", "while"})};
+
+    const Comb_table comb{dfa};
+    const Default_table table{dfa};
+
+    EXPECT_GT(table.depth(), 0);
+    EXPECT_LT(table.bytes(), comb.bytes());
+
+    // Without default states, only the live entries are stored, as in the comb layout.
+    const Default_table flat{dfa, 0};
+
+    EXPECT_EQ(flat.depth(), 0);
+    EXPECT_GT(flat.bytes(), table.bytes());
+
+    expect_equivalent(table, Table{dfa});
+}
+
+TEST_F(Default_table_test, Narrow_entries)
+{
+    const auto dfa{keywords({"break", "case", "continue", "default", "return", "switch", "typedef", "while"})};
+
+    const Default_table wide{dfa};
+
+    ASSERT_TRUE(Default_table<std::uint16_t>::fits(wide));
+
+    const Default_table<std::uint16_t> table{wide};
+
+    EXPECT_EQ(table.depth(), wide.depth());
+    EXPECT_EQ(table.bytes() * sizeof(Default_table<>::State_t), wide.bytes() * sizeof(std::uint16_t));
+
+    expect_equivalent(table, Table{dfa});
+    expect_equivalent(Default_table<std::uint32_t>{dfa}, Table{dfa});
+}
+
+TEST_F(Default_table_test, Missing_transitions)
+{
+    dfa::Builder dfa;
+
+    // The state after "a" lacks the transitions on digits of the identifier state it otherwise matches.
+    const auto identifier{dfa.next_state()};
+    const auto a{dfa.next_state()};
+
+    dfa.add_accept_state(identifier, Token{1});
+    dfa.add_accept_state(a, Token{2});
+
+    dfa.add_transition(dfa.init_state(), dfa::Label('a'), a);
+    dfa.add_transition(dfa.init_state(), dfa::Label('b', 'z'), identifier);
+    dfa.add_transition(identifier, dfa::Label('a', 'z'), identifier);
+    dfa.add_transition(identifier, dfa::Label('0', '9'), identifier);
+    dfa.add_transition(a, dfa::Label('a', 'z'), identifier);
+
+    const auto result{dfa.build()};
+
+    const Default_table table{result};
+
+    expect_equivalent(table, Table{result});
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(table, std::string{"a1"}), Result_t(Token{2}, 1));
+    EXPECT_EQ(Simulator::run(table, std::string{"ab1"}), Result_t(Token{1}, 3));
+}
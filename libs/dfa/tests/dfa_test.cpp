@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/minimize.hpp"
 #include "lexer/dfa/simulator.hpp"
 #include "lexer/dfa/tools/graphviz.hpp"
 
@@ -14,6 +15,23 @@ using namespace lexer;
 using namespace lexer::dfa;
 using namespace lexer::dfa::tools;
 
+namespace
+{
+// Counts the transitions of a DFA over the edges of all its states.
+std::size_t edge_count(const Dfa& dfa)
+{
+    std::size_t count{0};
+
+    for (Dfa::State_t state{0}; state < dfa.size(); ++state)
+    {
+        count += dfa.edges(state).size();
+    }
+
+    return count;
+}
+
+} // namespace
+
 class Dfa_test : public testing::Test
 {
 protected:
@@ -338,3 +356,48 @@ TEST_F(Dfa_test, Loop_plus_a)
     EXPECT_EQ(Simulator::run(result, ""), Result_t(std::nullopt, 0));
     EXPECT_EQ(Simulator::run(result, "b"), Result_t(std::nullopt, 0));
 }
+
+TEST_F(Dfa_test, Range_labels)
+{
+    dfa::Builder dfa;
+
+    // [a-z][0-9]*, with the letters split over two ranges leading to equivalent states.
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q1, token);
+    dfa.add_accept_state(q2, token);
+
+    dfa.add_transition(q0, dfa::Label('a', 'm'), q1);
+    dfa.add_transition(q0, dfa::Label('n', 'z'), q2);
+    dfa.add_transition(q1, dfa::Label('0', '9'), q1);
+    dfa.add_transition(q2, dfa::Label('0', '9'), q2);
+
+    const auto result{dfa.build()};
+
+    EXPECT_EQ(Dfa::advance(result, q0, 'a'), q1);
+    EXPECT_EQ(Dfa::advance(result, q0, 'm'), q1);
+    EXPECT_EQ(Dfa::advance(result, q0, 'n'), q2);
+    EXPECT_EQ(Dfa::advance(result, q0, 'z'), q2);
+    EXPECT_EQ(Dfa::advance(result, q0, '`'), std::nullopt);
+    EXPECT_EQ(Dfa::advance(result, q0, '{'), std::nullopt);
+    EXPECT_EQ(Dfa::advance(result, q1, '5'), q1);
+
+    const auto minimized{minimize(result)};
+
+    EXPECT_EQ(edge_count(minimized), 3);
+
+    using Result_t = Simulator::Result_t;
+
+    for (const std::string input : {"a", "m1", "n", "z42", "0", "az", ""})
+    {
+        EXPECT_EQ(Simulator::run(minimized, input), Simulator::run(result, input)) << input;
+    }
+
+    EXPECT_EQ(Simulator::run(minimized, "q123x"), Result_t(token, 4));
+
+    EXPECT_THROW(dfa::Label('z', 'a'), std::invalid_argument);
+}
@@ -0,0 +1,158 @@
+#include "lexer/dfa/minimize.hpp"
+
+#include <gtest/gtest.h>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/simulator.hpp"
+#include "lexer/dfa/table.hpp"
+
+using namespace lexer;
+using namespace lexer::dfa;
+
+namespace
+{
+// Counts the transitions of a DFA over the edges of all its states.
+std::size_t edge_count(const Dfa& dfa)
+{
+    std::size_t count{0};
+
+    for (Dfa::State_t state{0}; state < dfa.size(); ++state)
+    {
+        count += dfa.edges(state).size();
+    }
+
+    return count;
+}
+
+} // namespace
+
+using Minimize_test = testing::Test;
+
+TEST_F(Minimize_test, Test_empty)
+{
+    const dfa::Builder dfa;
+
+    const auto result{minimize(dfa.build())};
+
+    EXPECT_EQ(Table{result}.size(), 1);
+    EXPECT_TRUE(edge_count(result) == 0);
+    EXPECT_TRUE(result.accept_states().empty());
+}
+
+TEST_F(Minimize_test, Merge_equivalent_states)
+{
+    dfa::Builder dfa;
+
+    // (a|b)c, with separate states after 'a' and 'b'.
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+    const auto q3{dfa.next_state()};
+    const auto q4{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q3, token);
+    dfa.add_accept_state(q4, token);
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q0, dfa::Label('b'), q2);
+    dfa.add_transition(q1, dfa::Label('c'), q3);
+    dfa.add_transition(q2, dfa::Label('c'), q4);
+
+    const auto original{dfa.build()};
+
+    const auto result{minimize(original)};
+
+    EXPECT_EQ(Table{result}.size(), 3);
+    EXPECT_EQ(edge_count(result), 3);
+    EXPECT_EQ(result.accept_states().size(), 1);
+
+    for (const std::string input : {"", "a", "ac", "bc", "acc", "cc", "b"})
+    {
+        EXPECT_EQ(Simulator::run(result, input), Simulator::run(original, input)) << input;
+    }
+}
+
+TEST_F(Minimize_test, Keep_distinct_tokens)
+{
+    dfa::Builder dfa;
+
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+
+    const Token token_a{1};
+    const Token token_b{2};
+
+    dfa.add_accept_state(q1, token_a);
+    dfa.add_accept_state(q2, token_b);
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q0, dfa::Label('b'), q2);
+
+    const auto result{minimize(dfa.build())};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Table{result}.size(), 3);
+    EXPECT_EQ(Simulator::run(result, "a"), Result_t(token_a, 1));
+    EXPECT_EQ(Simulator::run(result, "b"), Result_t(token_b, 1));
+}
+
+TEST_F(Minimize_test, Remove_unproductive_states)
+{
+    dfa::Builder dfa;
+
+    // 'a' accepts; 'x' leads into a loop from which nothing is accepted.
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q1, token);
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q0, dfa::Label('x'), q2);
+    dfa.add_transition(q2, dfa::Label('x'), q2);
+
+    const auto result{minimize(dfa.build())};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Table{result}.size(), 2);
+    EXPECT_EQ(edge_count(result), 1);
+    EXPECT_EQ(Simulator::run(result, "a"), Result_t(token, 1));
+    EXPECT_EQ(Simulator::run(result, "xxa"), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Minimize_test, Merge_loop)
+{
+    dfa::Builder dfa;
+
+    // a+ unrolled over three states.
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+    const auto q3{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q1, token);
+    dfa.add_accept_state(q2, token);
+    dfa.add_accept_state(q3, token);
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q1, dfa::Label('a'), q2);
+    dfa.add_transition(q2, dfa::Label('a'), q3);
+    dfa.add_transition(q3, dfa::Label('a'), q1);
+
+    const auto result{minimize(dfa.build())};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Table{result}.size(), 2);
+    EXPECT_EQ(Simulator::run(result, "aaaaa"), Result_t(token, 5));
+    EXPECT_EQ(Simulator::run(result, "b"), Result_t(std::nullopt, 0));
+}
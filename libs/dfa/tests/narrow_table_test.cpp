@@ -0,0 +1,125 @@
+#include "lexer/dfa/narrow_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <string>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/simulator.hpp"
+#include "lexer/dfa/table.hpp"
+
+using namespace lexer;
+using namespace lexer::dfa;
+
+class Narrow_table_test : public testing::Test
+{
+protected:
+    // Builds a DFA accepting the words over [a-z] with `length` letters 'a', in three classes: 'a', [b-z] and others.
+    static Dfa chain(const std::size_t length)
+    {
+        dfa::Builder dfa;
+
+        auto from{dfa.init_state()};
+
+        for (std::size_t count{0}; count < length; ++count)
+        {
+            const auto to{dfa.next_state()};
+
+            dfa.add_transition(from, dfa::Label('a'), to);
+            dfa.add_transition(from, dfa::Label('b', 'z'), from);
+
+            from = to;
+        }
+
+        dfa.add_accept_state(from, Token{1});
+
+        return dfa.build();
+    }
+};
+
+TEST_F(Narrow_table_test, Test_empty)
+{
+    const dfa::Builder dfa;
+
+    const Narrow_table<std::uint8_t> table{dfa.build()};
+
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.index(table.init_state()), dfa.init_state());
+    EXPECT_EQ(table.next(table.init_state(), 'a'), Narrow_table<std::uint8_t>::dead_state);
+    EXPECT_EQ(table.accept_token(table.init_state()), std::nullopt);
+}
+
+TEST_F(Narrow_table_test, Matches_dense_table)
+{
+    const auto dfa{chain(5)};
+
+    const Table dense{dfa};
+    const Narrow_table<std::uint8_t> table{dense};
+
+    ASSERT_EQ(table.size(), dense.size());
+
+    // Rows of 3 classes take 3 entries, of one byte instead of eight.
+    EXPECT_EQ(table.bytes() * 8, dense.bytes());
+
+    // States are numbered by the offset of their rows, the accepting state first.
+    EXPECT_TRUE(table.accepts(0));
+    EXPECT_EQ(table.init_state(), 3);
+    EXPECT_EQ(table.index(table.init_state()), 1);
+    EXPECT_EQ(table.next(table.init_state(), 'a'), 6);
+    EXPECT_EQ(table.next(table.init_state(), 'b'), table.init_state());
+
+    auto narrow{table.init_state()};
+
+    for (auto state{dense.init_state()}; state != Table::dead_state; state = dense.next(state, 'a'))
+    {
+        ASSERT_NE(narrow, Narrow_table<std::uint8_t>::dead_state);
+
+        EXPECT_EQ(table.accepts(narrow), dense.accept_token(state).has_value());
+        EXPECT_EQ(table.accept_token(narrow), dense.accept_token(state));
+
+        for (unsigned symbol{0}; symbol < Classes::alphabet_size; ++symbol)
+        {
+            const auto to{table.next(narrow, static_cast<Label::Symbol_t>(symbol))};
+
+            EXPECT_EQ(to == Narrow_table<std::uint8_t>::dead_state,
+                    dense.next(state, static_cast<Label::Symbol_t>(symbol)) == Table::dead_state);
+        }
+
+        narrow = table.next(narrow, 'a');
+    }
+
+    for (const std::string input : {"", "aaa", "aaaaa", "abababaaa", "aaaaaa", "aaaa1"})
+    {
+        EXPECT_EQ(Simulator::run(table, input), Simulator::run(dfa, input)) << input;
+
+        const std::list<char> list(input.begin(), input.end());
+
+        EXPECT_EQ(Simulator::run(table, list), Simulator::run(dfa, input)) << input;
+
+        Memo memo{table.size(), input.size()};
+
+        EXPECT_EQ(Simulator::run(table, input.begin(), input.end(), memo, 0), Simulator::run(dfa, input)) << input;
+    }
+}
+
+TEST_F(Narrow_table_test, Fit_state_type)
+{
+    // 85 states of 3 classes take offsets up to 252, 86 states up to 255, the dead state of 8-bit identifiers.
+    const Table small{chain(84)};
+    const Table large{chain(85)};
+
+    EXPECT_TRUE(Narrow_table<std::uint8_t>::fits(small));
+    EXPECT_FALSE(Narrow_table<std::uint8_t>::fits(large));
+    EXPECT_TRUE(Narrow_table<std::uint16_t>::fits(large));
+
+    EXPECT_THROW(Narrow_table<std::uint8_t>{large}, std::length_error);
+
+    const Narrow_table<std::uint16_t> table{large};
+
+    const std::string input(85, 'a');
+
+    EXPECT_EQ(Simulator::run(table, input), Simulator::Result_t(Token{1}, 85));
+}
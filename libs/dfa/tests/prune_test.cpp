@@ -0,0 +1,130 @@
+#include "lexer/dfa/prune.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <string>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/simulator.hpp"
+#include "lexer/dfa/table.hpp"
+
+using namespace lexer;
+using namespace lexer::dfa;
+
+namespace
+{
+// Counts the transitions of a DFA over the edges of all its states.
+std::size_t edge_count(const Dfa& dfa)
+{
+    std::size_t count{0};
+
+    for (Dfa::State_t state{0}; state < dfa.size(); ++state)
+    {
+        count += dfa.edges(state).size();
+    }
+
+    return count;
+}
+
+} // namespace
+
+using Prune_test = testing::Test;
+
+TEST_F(Prune_test, Test_empty)
+{
+    const dfa::Builder dfa;
+
+    const auto result{prune(dfa.build())};
+
+    EXPECT_EQ(Table{result}.size(), 1);
+    EXPECT_TRUE(edge_count(result) == 0);
+    EXPECT_TRUE(result.accept_states().empty());
+}
+
+TEST_F(Prune_test, Drop_unproductive_states)
+{
+    dfa::Builder dfa;
+
+    // "ab", or 'a' followed by any number of letters that never lead to an accepting state.
+    const auto q0{dfa.init_state()};
+    const auto a{dfa.next_state()};
+    const auto ab{dfa.next_state()};
+    const auto trap{dfa.next_state()};
+
+    dfa.add_accept_state(ab, Token{1});
+
+    dfa.add_transition(q0, dfa::Label('a'), a);
+    dfa.add_transition(a, dfa::Label('b'), ab);
+    dfa.add_transition(a, dfa::Label('c', 'z'), trap);
+    dfa.add_transition(trap, dfa::Label('a', 'z'), trap);
+
+    const auto original{dfa.build()};
+
+    const auto result{prune(original)};
+
+    EXPECT_EQ(Table{result}.size(), 3);
+    EXPECT_EQ(edge_count(result), 2);
+
+    for (const std::string input : {"", "a", "ab", "abc", "ac", "acdef", "b"})
+    {
+        EXPECT_EQ(Simulator::run(result, input), Simulator::run(original, input)) << input;
+    }
+
+    // The scan of a non-matching run stops on its second symbol instead of its end.
+    const std::string input{"acdefghij"};
+
+    std::string consumed;
+
+    const auto scan{Simulator::scan(Table{result}, input.begin(), input.end(), std::back_inserter(consumed))};
+
+    EXPECT_EQ(scan.token, std::nullopt);
+    EXPECT_EQ(scan.consumed, 1);
+
+    EXPECT_EQ(Simulator::scan(Table{original}, input.begin(), input.end(), std::back_inserter(consumed)).consumed,
+            input.size());
+}
+
+TEST_F(Prune_test, Drop_unreachable_states)
+{
+    dfa::Builder dfa;
+
+    const auto q0{dfa.init_state()};
+    const auto a{dfa.next_state()};
+    const auto unreachable{dfa.next_state()};
+
+    dfa.add_accept_state(a, Token{1});
+    dfa.add_accept_state(unreachable, Token{2});
+
+    dfa.add_transition(q0, dfa::Label('a'), a);
+    dfa.add_transition(unreachable, dfa::Label('a'), a);
+
+    const auto result{prune(dfa.build())};
+
+    EXPECT_EQ(Table{result}.size(), 2);
+    EXPECT_EQ(result.accept_states().size(), 1);
+    EXPECT_EQ(Simulator::run(result, std::string{"a"}), Simulator::Result_t(Token{1}, 1));
+}
+
+TEST_F(Prune_test, Keep_equivalent_states)
+{
+    dfa::Builder dfa;
+
+    // (a|b)c, with separate states after 'a' and 'b', which minimization would merge.
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+    const auto q3{dfa.next_state()};
+
+    dfa.add_accept_state(q3, Token{1});
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q0, dfa::Label('b'), q2);
+    dfa.add_transition(q1, dfa::Label('c'), q3);
+    dfa.add_transition(q2, dfa::Label('c'), q3);
+
+    const auto result{prune(dfa.build())};
+
+    EXPECT_EQ(Table{result}.size(), 4);
+    EXPECT_EQ(edge_count(result), 4);
+}
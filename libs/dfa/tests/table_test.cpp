@@ -0,0 +1,206 @@
+#include "lexer/dfa/table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <list>
+#include <sstream>
+
+#include "lexer/dfa/builder.hpp"
+#include "lexer/dfa/simulator.hpp"
+
+using namespace lexer;
+using namespace lexer::dfa;
+
+class Table_test : public testing::Test
+{
+protected:
+    // Builds a DFA for a(ba)*, accepting after every 'a' with token 1.
+    static Dfa alternation()
+    {
+        dfa::Builder dfa;
+
+        const auto q0{dfa.init_state()};
+        const auto q1{dfa.next_state()};
+        const auto q2{dfa.next_state()};
+
+        dfa.add_accept_state(q1, Token{1});
+
+        dfa.add_transition(q0, dfa::Label('a'), q1);
+        dfa.add_transition(q1, dfa::Label('b'), q2);
+        dfa.add_transition(q2, dfa::Label('a'), q1);
+
+        return dfa.build();
+    }
+};
+
+TEST_F(Table_test, Test_empty)
+{
+    const dfa::Builder dfa;
+
+    const Table table{dfa.build()};
+
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.init_state(), dfa.init_state());
+    EXPECT_EQ(table.next(table.init_state(), 'a'), Table::dead_state);
+    EXPECT_EQ(table.accept_token(table.init_state()), std::nullopt);
+
+    constexpr std::vector<char> input;
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(table, input), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Table_test, Transitions)
+{
+    dfa::Builder dfa;
+
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q2, token);
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q1, dfa::Label('b'), q2);
+    dfa.add_transition(q2, dfa::Label('\xFF'), q0);
+
+    const Table table{dfa.build()};
+
+    EXPECT_EQ(table.size(), 3);
+
+    EXPECT_EQ(table.next(q0, 'a'), q1);
+    EXPECT_EQ(table.next(q1, 'b'), q2);
+    EXPECT_EQ(table.next(q2, '\xFF'), q0);
+
+    EXPECT_EQ(table.next(q0, 'b'), Table::dead_state);
+    EXPECT_EQ(table.next(q1, 'a'), Table::dead_state);
+    EXPECT_EQ(table.next(q2, '\0'), Table::dead_state);
+
+    EXPECT_EQ(table.accept_token(q0), std::nullopt);
+    EXPECT_EQ(table.accept_token(q1), std::nullopt);
+    EXPECT_EQ(table.accept_token(q2), token);
+}
+
+TEST_F(Table_test, Simulator_matches_dfa)
+{
+    dfa::Builder dfa;
+
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+    const auto q3{dfa.next_state()};
+
+    const Token token_a{1};
+    const Token token_abc{2};
+
+    dfa.add_accept_state(q1, token_a);
+    dfa.add_accept_state(q3, token_abc);
+
+    dfa.add_transition(q0, dfa::Label('a'), q1);
+    dfa.add_transition(q1, dfa::Label('b'), q2);
+    dfa.add_transition(q2, dfa::Label('c'), q3);
+    dfa.add_transition(q3, dfa::Label('a'), q1);
+
+    const auto result{dfa.build()};
+
+    const Table table{result};
+
+    for (const std::string input : {"", "a", "ab", "abc", "abca", "abcab", "abcabc", "b", "xa", "aa"})
+    {
+        EXPECT_EQ(Simulator::run(table, input), Simulator::run(result, input)) << input;
+    }
+}
+
+TEST_F(Table_test, Byte_classes)
+{
+    dfa::Builder dfa;
+
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+    const auto q2{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q1, token);
+    dfa.add_accept_state(q2, token);
+
+    for (const auto symbol : {'a', 'b', 'c'})
+    {
+        dfa.add_transition(q0, dfa::Label(symbol), q1);
+        dfa.add_transition(q1, dfa::Label(symbol), q1);
+    }
+
+    dfa.add_transition(q0, dfa::Label('0'), q2);
+    dfa.add_transition(q1, dfa::Label('0'), q1);
+
+    const Table table{dfa.build()};
+
+    const auto& classes{table.classes()};
+
+    // {a, b, c}, {0} and every other byte.
+    EXPECT_EQ(classes.size(), 3);
+
+    EXPECT_EQ(classes['a'], classes['b']);
+    EXPECT_EQ(classes['a'], classes['c']);
+    EXPECT_NE(classes['a'], classes['0']);
+    EXPECT_NE(classes['a'], classes['d']);
+    EXPECT_NE(classes['0'], classes['1']);
+    EXPECT_EQ(classes['d'], classes['\xFF']);
+    EXPECT_EQ(classes['d'], classes['\0']);
+
+    EXPECT_EQ(classes[classes.representative(classes['b'])], classes['b']);
+    EXPECT_EQ(classes.representative(classes['c']), 'a');
+
+    EXPECT_EQ(table.next(q0, 'b'), q1);
+    EXPECT_EQ(table.next(q0, '0'), q2);
+    EXPECT_EQ(table.next(q1, '0'), q1);
+    EXPECT_EQ(table.next(q2, 'a'), Table::dead_state);
+    EXPECT_EQ(table.next(q0, 'd'), Table::dead_state);
+}
+
+TEST_F(Table_test, Non_contiguous_input)
+{
+    const Table table{alternation()};
+
+    for (const std::string input : {"", "a", "ab", "aba", "ababx", "b"})
+    {
+        const std::list<char> list(input.begin(), input.end());
+
+        EXPECT_EQ(Simulator::run(table, list), Simulator::run(table, input)) << input;
+    }
+}
+
+TEST_F(Table_test, Single_pass_input)
+{
+    const Table table{alternation()};
+
+    std::istringstream stream{"ababx"};
+
+    std::string consumed;
+
+    const auto result{Simulator::scan(
+            table, std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{},
+            std::back_inserter(consumed))};
+
+    EXPECT_EQ(result.token, Token{1});
+    EXPECT_EQ(result.length, 3);
+    EXPECT_EQ(result.consumed, 4);
+    EXPECT_EQ(consumed, "abab");
+
+    // The symbol on which the DFA dies is left in the input.
+    EXPECT_EQ(stream.get(), 'x');
+
+    std::istringstream empty;
+
+    const auto none{Simulator::scan(
+            table, std::istreambuf_iterator<char>{empty}, std::istreambuf_iterator<char>{},
+            std::back_inserter(consumed))};
+
+    EXPECT_EQ(none.token, std::nullopt);
+    EXPECT_EQ(none.length, 0);
+    EXPECT_EQ(none.consumed, 0);
+}
@@ -1,12 +1,49 @@
 #include "lexer/dfa/tools/graphviz.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <ranges>
 #include <stdexcept>
 
+namespace
+{
+/**
+ * Writes a symbol to a Graphviz label, escaping quotes, backslashes and non-printable bytes.
+ */
+void write_symbol(std::ostream& oss, const lexer::dfa::Label::Symbol_t symbol)
+{
+    switch (symbol)
+    {
+    case '\"':
+        oss << "\\\"";
+        break;
+    case '\\':
+        oss << "\\\\";
+        break;
+    case '\n':
+        oss << "\\n";
+        break;
+    case '\t':
+        oss << "\\t";
+        break;
+    default:
+        if (std::isprint(symbol))
+        {
+            oss << static_cast<char>(symbol);
+        }
+        else
+        {
+            oss << "\\x" << std::hex << std::uppercase << std::setfill('0') << std::setw(2)
+                << static_cast<unsigned>(symbol);
+        }
+    }
+}
+
+} // namespace
+
 namespace lexer::dfa::tools
 {
 void Graphviz::to_file(const Dfa& dfa, const std::filesystem::path& path)
@@ -45,11 +82,12 @@ std::string Graphviz::to_dot(const Dfa& dfa)
     oss << "    __start__ [shape = none, label=\"\"];\n";
     oss << "    __start__ -> " << dfa.init_state() << ";\n";
 
-    for (const auto& [key, state] : dfa.transitions())
+    for (Dfa::State_t from_state{0}; from_state < dfa.size(); ++from_state)
     {
-        const auto& [from_state, transition]{key};
-
-        oss << "    " << from_state << " -> " << state << " [label = " << create_label(transition) << "];\n";
+        for (const auto& [transition, state] : dfa.edges(from_state))
+        {
+            oss << "    " << from_state << " -> " << state << " [label = " << create_label(transition) << "];\n";
+        }
     }
 
     oss << "}\n";
@@ -63,30 +101,17 @@ std::string Graphviz::create_label(const Label& label)
 
     oss << '"';
 
-    switch (const auto symbol{label.symbol()})
+    if (label.first() == label.last())
     {
-    case '\"':
-        oss << "\\\"";
-        break;
-    case '\\':
-        oss << "\\\\";
-        break;
-    case '\n':
-        oss << "\\n";
-        break;
-    case '\t':
-        oss << "\\t";
-        break;
-    default:
-        if (isprint(symbol))
-        {
-            oss << symbol;
-        }
-        else
-        {
-            oss << "\\x" << std::hex << std::uppercase << std::setfill('0') << std::setw(2)
-                << (static_cast<unsigned char>(symbol) & 0xFF);
-        }
+        write_symbol(oss, label.first());
+    }
+    else
+    {
+        oss << '[';
+        write_symbol(oss, label.first());
+        oss << '-';
+        write_symbol(oss, label.last());
+        oss << ']';
     }
 
     oss << '"';
@@ -185,3 +185,33 @@ TEST_F(Graphviz_test, Graphviz_to_dot_non_printable_characters)
     EXPECT_NE(dot_output.find("node [shape = circle]"), std::string::npos);
     EXPECT_NE(dot_output.find("1 [shape = doublecircle, label=\"1 (1)\"]"), std::string::npos);
 }
+
+TEST_F(Graphviz_test, Graphviz_range_label)
+{
+    dfa::Builder dfa;
+
+    const auto q0{dfa.init_state()};
+    const auto q1{dfa.next_state()};
+
+    const Token token{1};
+
+    dfa.add_accept_state(q1, token);
+    dfa.add_transition(q0, dfa::Label(0x80, 0xFF), q1);
+
+    const auto result{dfa.build()};
+
+    const std::string dot_output = Graphviz::to_dot(result);
+
+    const std::string expected_output =
+            "digraph DFA {\n"
+            "    rankdir=LR;\n"
+            "    ratio=1.0;\n"
+            "    node [shape = circle];\n"
+            "    1 [shape = doublecircle, label=\"1 (1)\"];\n"
+            "    __start__ [shape = none, label=\"\"];\n"
+            "    __start__ -> 0;\n"
+            "    0 -> 1 [label = \"[\\x80-\\xFF]\"];\n"
+            "}\n";
+
+    EXPECT_EQ(dot_output, expected_output);
+}
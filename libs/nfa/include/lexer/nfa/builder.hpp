@@ -1,6 +1,8 @@
 #ifndef LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_BUILDER_HPP
 #define LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_BUILDER_HPP
 
+#include <optional>
+
 #include "lexer/nfa/label.hpp"
 #include "lexer/nfa/nfa.hpp"
 
@@ -14,6 +16,39 @@ namespace lexer::nfa
 class Builder
 {
 public:
+    /**
+     * @brief Ordered set of NFA states.
+     *
+     * Using std::set ensures deterministic iteration order over the destinations of a transition.
+     */
+    using States_t = Nfa::Map_states_t;
+
+    /**
+     * @brief NFA transition key type.
+     *
+     * Represents a pair of `(from_state, Label)` used as the key in transition maps.
+     */
+    using Key_t = Nfa::Map_key_t;
+
+    /**
+     * @brief Hash functor used to combine state and label into a transition key hash.
+     */
+    using Hash = Nfa::Map_hash;
+
+    /**
+     * @brief NFA transition table type.
+     *
+     * Maps each `(state, label)` pair to a set of destination states.
+     */
+    using Transitions_t = Nfa::Map_transitions_t;
+
+    /**
+     * @brief Accept-state table type for the NFA.
+     *
+     * Maps accepting states to an optional token, indicating the token accepted by that state.
+     */
+    using Accept_states_t = Nfa::Map_accept_states_t;
+
     /**
      * @brief Constructs a new NFA Builder.
      */
@@ -35,13 +70,13 @@ public:
      * @brief Returns the transition table of the NFA.
      * @return Reference to the transitions map.
      */
-    [[nodiscard]] const Nfa::Transitions_t& transitions() const noexcept;
+    [[nodiscard]] const Transitions_t& transitions() const noexcept;
 
     /**
      * @brief Returns the accept states and their associated tokens.
      * @return Reference to the accept states map.
      */
-    [[nodiscard]] const Nfa::Accept_states_t& accept_states() const noexcept;
+    [[nodiscard]] const Accept_states_t& accept_states() const noexcept;
 
     /**
      * @brief Adds a transition from one state to another on a given label.
@@ -75,12 +110,23 @@ public:
      */
     Builder& add_accept_state(Nfa::State_t accept_state, const Token& token);
 
+    /**
+     * @brief Marks a state as an accept state, keeping the token with the highest priority if it already accepts one.
+     *
+     * A state accepting an unset token keeps it, so that a token set later applies to it as well.
+     *
+     * @param accept_state The state to mark as accepting.
+     * @param token The token associated with this accept state, or std::nullopt to set it later.
+     * @return Reference to this Builder for chaining.
+     */
+    Builder& add_accept_state_by_priority(Nfa::State_t accept_state, const std::optional<Token>& token);
+
     /**
      * @brief Sets the accept states for the NFA.
      * @param accept_states The accept states map to set.
      * @return Reference to this Builder for chaining.
      */
-    Builder& set_accept_states(Nfa::Accept_states_t accept_states);
+    Builder& set_accept_states(Accept_states_t accept_states);
 
     /**
      * @brief Sets the accept token for all accept states.
@@ -101,14 +147,31 @@ public:
      * @param other The Builder to append.
      * @return A new Builder representing the appended NFA.
      */
-    [[nodiscard]] Builder append(const Builder& other) const;
+    [[nodiscard]] Builder append(const Builder& other) const&;
+
+    /**
+     * @brief Appends another Builder's NFA in place, copying only the states of `other`.
+     * @param other The Builder to append, which may be this Builder itself.
+     * @return This Builder, moved, representing the appended NFA.
+     */
+    [[nodiscard]] Builder append(const Builder& other) &&;
 
     /**
      * @brief Returns a new Builder by merging another Builder's NFA.
      * @param other The Builder to merge.
      * @return A new Builder representing the merged NFA.
      */
-    [[nodiscard]] Builder merge(const Builder& other) const;
+    [[nodiscard]] Builder merge(const Builder& other) const&;
+
+    /**
+     * @brief Merges another Builder's NFA in place, copying only the states of `other`.
+     *
+     * Merging N NFAs in sequence thus takes time linear in their total size.
+     *
+     * @param other The Builder to merge, which may be this Builder itself.
+     * @return This Builder, moved, representing the merged NFA.
+     */
+    [[nodiscard]] Builder merge(const Builder& other) &&;
 
     /**
      * @brief Builds and returns the constructed NFA.
@@ -117,16 +180,23 @@ public:
     [[nodiscard]] Nfa build() const;
 
 private:
-    Builder(Nfa::State_t init_state, Nfa::State_t next_state, Nfa::Transitions_t transitions,
-            Nfa::Accept_states_t accept_states);
+    Builder(Nfa::State_t init_state, Nfa::State_t next_state, Transitions_t transitions,
+            Accept_states_t accept_states);
+
+    /**
+     * @brief Copies the transitions and accept states of another Builder, offset past the states of this one.
+     * @param other The Builder to copy from.
+     * @return The offset applied to the states of `other`.
+     */
+    Nfa::State_t insert(const Builder& other);
 
     Nfa::State_t init_state_;
 
     Nfa::State_t next_state_;
 
-    Nfa::Transitions_t transitions_;
+    Transitions_t transitions_;
 
-    Nfa::Accept_states_t accept_states_;
+    Accept_states_t accept_states_;
 };
 
 } // namespace lexer::nfa
@@ -1,6 +1,7 @@
 #ifndef LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_LABEL_HPP
 #define LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_LABEL_HPP
 
+#include <cstdint>
 #include <variant>
 
 namespace lexer::nfa
@@ -19,29 +20,64 @@ public:
 };
 
 /**
- * @brief Represents a transition label for NFA transitions (symbol or epsilon).
+ * @brief Represents a transition label for NFA transitions (symbol range or epsilon).
+ *
+ * A symbol label matches every symbol of the closed range `[first, last]`, so a character class is a handful of range
+ * edges rather than one edge per character.
  */
 class Label
 {
 public:
     /**
      * @brief Symbol type used in NFA transitions.
+     *
+     * Symbols are unsigned bytes, so the whole 8-bit alphabet is ordered and usable as an index.
      */
-    using Symbol_t = char;
+    using Symbol_t = std::uint8_t;
+
+    /**
+     * @brief Closed range of symbols matched by a symbol label.
+     */
+    struct Range
+    {
+        /**
+         * @brief The lowest symbol of the range.
+         */
+        Symbol_t first;
+
+        /**
+         * @brief The highest symbol of the range.
+         */
+        Symbol_t last;
+
+        /**
+         * @brief Equality comparison operator for ranges.
+         * @return True if both bounds are equal.
+         */
+        bool operator==(const Range&) const noexcept = default;
+    };
 
     /**
      * @brief Label variant type.
      *
-     * Stores either an `Epsilon` (ε-transition) or a concrete `Symbol_t` character.
+     * Stores either an `Epsilon` (ε-transition) or a `Range` of symbols.
      */
-    using Variant_t = std::variant<Symbol_t, Epsilon>;
+    using Variant_t = std::variant<Range, Epsilon>;
 
     /**
-     * @brief Constructs a label with the given symbol.
+     * @brief Constructs a label matching a single symbol.
      * @param s The symbol for the label.
      */
     explicit Label(Symbol_t s) noexcept;
 
+    /**
+     * @brief Constructs a label matching a closed range of symbols.
+     * @param first The lowest symbol of the range.
+     * @param last The highest symbol of the range.
+     * @throws std::invalid_argument if `first` is greater than `last`.
+     */
+    Label(Symbol_t first, Symbol_t last);
+
     /**
      * @brief Returns a label representing an epsilon transition.
      * @return An epsilon label.
@@ -49,8 +85,8 @@ public:
     [[nodiscard]] static Label epsilon() noexcept;
 
     /**
-     * @brief Checks if the label is a symbol.
-     * @return True if the label is a symbol, false if epsilon.
+     * @brief Checks if the label consumes a symbol.
+     * @return True if the label is a symbol range, false if epsilon.
      */
     [[nodiscard]] bool is_symbol() const noexcept;
 
@@ -61,14 +97,37 @@ public:
     [[nodiscard]] bool is_epsilon() const noexcept;
 
     /**
-     * @brief Returns the symbol associated with this label.
-     * @return The symbol character.
-     * @throws std::bad_variant_access if not a symbol.
+     * @brief Returns the lowest symbol matched by this label.
+     * @return The first symbol of the range.
+     * @throws std::bad_variant_access if not a symbol label.
+     */
+    [[nodiscard]] Symbol_t first() const;
+
+    /**
+     * @brief Returns the highest symbol matched by this label.
+     * @return The last symbol of the range.
+     * @throws std::bad_variant_access if not a symbol label.
      */
-    [[nodiscard]] Symbol_t symbol() const;
+    [[nodiscard]] Symbol_t last() const;
 
     /**
-     * @brief Returns the underlying variant (symbol or epsilon).
+     * @brief Returns the symbol of a single-symbol label.
+     * @return The first symbol of the range.
+     * @throws std::bad_variant_access if not a symbol label.
+     * @pre The label matches a single symbol, i.e. `first() == last()`.
+     * @deprecated Labels match symbol ranges; use first() and last() instead.
+     */
+    [[deprecated("Labels match symbol ranges; use first() and last() instead")]] [[nodiscard]] Symbol_t symbol() const;
+
+    /**
+     * @brief Checks if the label matches a symbol.
+     * @param symbol The symbol to check.
+     * @return True if the symbol lies within the range, always false for epsilon.
+     */
+    [[nodiscard]] bool contains(Symbol_t symbol) const noexcept;
+
+    /**
+     * @brief Returns the underlying variant (symbol range or epsilon).
      * @return Reference to the variant.
      */
     [[nodiscard]] const Variant_t& variant() const noexcept;
@@ -97,6 +156,18 @@ struct std::hash<lexer::nfa::Epsilon>
     std::size_t operator()(const lexer::nfa::Epsilon&) const noexcept { return 0; }
 };
 
+/**
+ * @brief Hash specialization for lexer::nfa::Label::Range to allow use in hash-based containers.
+ */
+template <>
+struct std::hash<lexer::nfa::Label::Range>
+{
+    std::size_t operator()(const lexer::nfa::Label::Range& range) const noexcept
+    {
+        return (static_cast<std::size_t>(range.first) << 8 | range.last) + 1;
+    }
+};
+
 /**
  * @brief Hash specialization for lexer::nfa::Label to allow use in hash-based containers.
  */
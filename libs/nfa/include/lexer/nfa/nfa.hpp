@@ -3,9 +3,12 @@
 
 #include <optional>
 #include <set>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 #include "lexer/nfa/label.hpp"
+#include "lexer/nfa/state_set.hpp"
 #include "lexer/nfa/token.hpp"
 
 namespace lexer::nfa
@@ -14,7 +17,11 @@ namespace lexer::nfa
  * @brief Represents a non-deterministic finite automaton (NFA).
  *
  * Provides methods for querying states, transitions, and accept states, as well as advancing the NFA and computing
- * epsilon closures.
+ * epsilon closures. On construction, the transitions are laid out in compressed sparse row form, with the symbol and
+ * epsilon edges of each state stored contiguously, and the NFA is immutable from then on.
+ *
+ * The map-based transition and accept-state tables are only kept by the Builder; the accessors and types that exposed
+ * them on the NFA are deprecated and rebuild the tables on demand.
  */
 class Nfa
 {
@@ -24,50 +31,86 @@ public:
      */
     using State_t = std::size_t;
 
+private:
+    friend class Builder;
+
+    // The tables a Builder assembles an NFA in, exposed as Builder::States_t, Builder::Key_t, and so on.
+    using Map_states_t = std::set<State_t>;
+
+    using Map_key_t = std::pair<State_t, Label>;
+
+    struct Map_hash
+    {
+        std::size_t operator()(const Map_key_t& key) const noexcept;
+    };
+
+    using Map_transitions_t = std::unordered_map<Map_key_t, Map_states_t, Map_hash>;
+
+    using Map_accept_states_t = std::unordered_map<State_t, std::optional<Token>>;
+
+public:
     /**
      * @brief Ordered set of NFA states.
-     *
-     * Using std::set ensures deterministic iteration order so state-sets can be safely used as keys during DFA subset
-     * construction.
+     * @deprecated The NFA stores its transitions as edges; use Builder::States_t instead.
      */
-    using States_t = std::set<State_t>;
+    using States_t [[deprecated("The NFA stores its transitions as edges; use Builder::States_t instead")]] =
+            Map_states_t;
 
     /**
      * @brief NFA transition key type.
-     *
-     * Represents a pair of `(from_state, Label)` used as the key in transition maps.
+     * @deprecated The NFA stores its transitions as edges; use Builder::Key_t instead.
      */
-    using Key_t = std::pair<State_t, Label>;
+    using Key_t [[deprecated("The NFA stores its transitions as edges; use Builder::Key_t instead")]] = Map_key_t;
 
     /**
      * @brief Hash functor used to combine state and label into a transition key hash.
+     * @deprecated The NFA stores its transitions as edges; use Builder::Hash instead.
      */
-    struct Hash
-    {
-        std::size_t operator()(const Key_t& key) const noexcept;
-    };
+    using Hash [[deprecated("The NFA stores its transitions as edges; use Builder::Hash instead")]] = Map_hash;
 
     /**
      * @brief NFA transition table type.
-     *
-     * Maps each `(state, label)` pair to a set of destination states.
+     * @deprecated The NFA stores its transitions as edges; use Builder::Transitions_t instead.
      */
-    using Transitions_t = std::unordered_map<Key_t, States_t, Hash>;
+    using Transitions_t [[deprecated("The NFA stores its transitions as edges; use Builder::Transitions_t instead")]] =
+            Map_transitions_t;
 
     /**
      * @brief Accept-state table type for the NFA.
-     *
-     * Maps accepting states to an optional token, indicating the token accepted by that state.
+     * @deprecated The NFA stores its accept states as a list; use Builder::Accept_states_t instead.
+     */
+    using Accept_states_t
+            [[deprecated("The NFA stores its accept states as a list; use Builder::Accept_states_t instead")]] =
+                    Map_accept_states_t;
+
+    /**
+     * @brief Symbol transition in the compressed adjacency layout.
      */
-    using Accept_states_t = std::unordered_map<State_t, std::optional<Token>>;
+    struct Edge
+    {
+        /**
+         * @brief The lowest symbol of the range labelling the transition.
+         */
+        Label::Symbol_t first;
+
+        /**
+         * @brief The highest symbol of the range labelling the transition.
+         */
+        Label::Symbol_t last;
+
+        /**
+         * @brief The destination state.
+         */
+        State_t to;
+    };
 
     /**
      * @brief Constructs an NFA with the given initial state, transitions, and accept states.
      * @param init_state The initial state of the NFA.
-     * @param transitions The transition table.
-     * @param accept_states The accept states and their associated tokens (optional).
+     * @param transitions The transition table of a Builder, laid out into the compressed edges.
+     * @param accept_states The accept states of a Builder and their associated tokens (optional).
      */
-    Nfa(State_t init_state, Transitions_t transitions, Accept_states_t accept_states);
+    Nfa(State_t init_state, const Map_transitions_t& transitions, const Map_accept_states_t& accept_states);
 
     /**
      * @brief Returns the initial state of the NFA.
@@ -77,15 +120,75 @@ public:
 
     /**
      * @brief Returns the transition table of the NFA.
-     * @return Reference to the transitions map.
+     * @return The transitions map, rebuilt from the edges on every call.
+     * @deprecated The NFA stores its transitions as edges; use edges() and epsilon_edges() instead.
      */
-    [[nodiscard]] const Transitions_t& transitions() const noexcept;
+    [[deprecated("The NFA stores its transitions as edges; use edges() and epsilon_edges() instead")]] [[nodiscard]]
+    Map_transitions_t transitions() const;
 
     /**
      * @brief Returns the accept states and their associated tokens.
-     * @return Reference to the accept states map.
+     * @return The accept states map, rebuilt from the accept states on every call.
+     * @deprecated The NFA stores its accept states as a list; use accepting_states() and accept_token() instead.
+     */
+    [[deprecated("The NFA stores its accept states as a list; use accepting_states() and accept_token() instead")]]
+    [[nodiscard]] Map_accept_states_t accept_states() const;
+
+    /**
+     * @brief Returns the accept states of the NFA.
+     * @return The accept states, in ascending order, including those accepting without a token.
+     */
+    [[nodiscard]] std::span<const State_t> accepting_states() const noexcept;
+
+    /**
+     * @brief Returns the number of states of the NFA.
+     * @return One past the highest state identifier.
      */
-    [[nodiscard]] const Accept_states_t& accept_states() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns the symbol transitions leaving a state.
+     * @param state The state, which must be lower than size().
+     * @return The edges, ordered by range and destination.
+     */
+    [[nodiscard]] std::span<const Edge> edges(State_t state) const noexcept;
+
+    /**
+     * @brief Returns the destinations of the epsilon transitions leaving a state.
+     * @param state The state, which must be lower than size().
+     * @return The destination states, in ascending order.
+     */
+    [[nodiscard]] std::span<const State_t> epsilon_edges(State_t state) const noexcept;
+
+    /**
+     * @brief Returns the token accepted by a state.
+     * @param state The state, which must be lower than size().
+     * @return The token if the state accepts one, otherwise std::nullopt.
+     */
+    [[nodiscard]] const std::optional<Token>& accept_token(State_t state) const noexcept;
+
+    /**
+     * @brief Computes and stores the epsilon closure of every state.
+     *
+     * Once precomputed, epsilon_closure() unions the stored closures instead of walking the epsilon transitions.
+     *
+     * @return Reference to this NFA.
+     */
+    Nfa& precompute_closures();
+
+    /**
+     * @brief Checks if the epsilon closures have been precomputed.
+     * @return True if precompute_closures() has been called.
+     */
+    [[nodiscard]] bool has_closures() const noexcept;
+
+    /**
+     * @brief Returns the precomputed epsilon closure of a state.
+     * @param state The state, which must be lower than size().
+     * @return The states reachable from `state` via epsilon transitions, including itself, in ascending order.
+     * @pre has_closures() is true.
+     */
+    [[nodiscard]] std::span<const State_t> closure(State_t state) const noexcept;
 
     /**
      * @brief Computes the epsilon closure of a set of states in the NFA.
@@ -93,7 +196,33 @@ public:
      * @param states The set of states to compute the closure for.
      * @return The set of states reachable via epsilon transitions.
      */
-    [[nodiscard]] static States_t epsilon_closure(const Nfa& nfa, const States_t& states);
+    [[nodiscard]] static State_set epsilon_closure(const Nfa& nfa, const State_set& states);
+
+    /**
+     * @brief Computes the epsilon closure of a set of states in the NFA, marking states in a caller-owned buffer.
+     *
+     * Repeated closures, as in the subset construction, reuse the buffer instead of allocating one per call; only the
+     * entries of the reached states are set and cleared again.
+     *
+     * @param nfa The NFA to operate on.
+     * @param states The set of states to compute the closure for.
+     * @param marked A buffer of `nfa.size()` entries, all false on entry and left all false on return.
+     * @return The set of states reachable via epsilon transitions.
+     */
+    [[nodiscard]] static State_set epsilon_closure(const Nfa& nfa, const State_set& states, std::vector<bool>& marked);
+
+    /**
+     * @brief Computes the epsilon closure of states into a caller-owned vector, without allocating a State_set.
+     *
+     * The subset construction looks the closure up by its states, so only the closures of new subsets are copied.
+     *
+     * @param nfa The NFA to operate on.
+     * @param states The states to compute the closure for, in any order and possibly repeated.
+     * @param marked A buffer of `nfa.size()` entries, all false on entry and left all false on return.
+     * @param result Replaced with the states reachable via epsilon transitions, in ascending order.
+     */
+    static void epsilon_closure(
+            const Nfa& nfa, std::span<const State_t> states, std::vector<bool>& marked, std::vector<State_t>& result);
 
     /**
      * @brief Advances the NFA from a set of states on an input symbol.
@@ -102,7 +231,16 @@ public:
      * @param symbol The input symbol.
      * @return The set of next states reachable on the symbol.
      */
-    [[nodiscard]] static States_t advance(const Nfa& nfa, const States_t& states, char symbol);
+    [[nodiscard]] static State_set advance(const Nfa& nfa, const State_set& states, Label::Symbol_t symbol);
+
+    /**
+     * @brief Follows the transitions on an input symbol from a set of states, without taking the epsilon closure.
+     * @param nfa The NFA to step.
+     * @param states The current set of states.
+     * @param symbol The input symbol.
+     * @return The set of states directly reachable on the symbol.
+     */
+    [[nodiscard]] static State_set step(const Nfa& nfa, const State_set& states, Label::Symbol_t symbol);
 
     /**
      * @brief Checks if any state in the set is an accept state and returns its token if so.
@@ -110,14 +248,40 @@ public:
      * @param states The set of states to check.
      * @return The associated token if any state is accepting, otherwise std::nullopt.
      */
-    [[nodiscard]] static std::optional<Token> has_accept_token(const Nfa& nfa, const States_t& states);
+    [[nodiscard]] static std::optional<Token> has_accept_token(const Nfa& nfa, const State_set& states);
 
 private:
+    /**
+     * @brief Walks the epsilon transitions from the states on a stack, collecting the newly reached states.
+     * @param stack The states to walk from, emptied on return.
+     * @param marked The states already collected, updated with the reached states.
+     * @param result The collected states, to which the reached states are appended.
+     */
+    void walk_epsilon(std::vector<State_t>& stack, std::vector<bool>& marked, std::vector<State_t>& result) const;
+
     State_t init_state_;
 
-    Transitions_t transitions_;
+    std::size_t size_;
+
+    // Compressed sparse row adjacency: the edges of state `s` are `edges_[edge_offsets_[s], edge_offsets_[s + 1])`,
+    // and likewise for the epsilon edges.
+    std::vector<std::size_t> edge_offsets_;
+
+    std::vector<Edge> edges_;
+
+    std::vector<std::size_t> epsilon_offsets_;
+
+    std::vector<State_t> epsilon_edges_;
+
+    std::vector<State_t> accepting_states_;
+
+    std::vector<std::optional<Token>> accept_tokens_;
+
+    // Precomputed epsilon closures in compressed sparse row form: the closure of state `s` is
+    // `closure_states_[closure_offsets_[s], closure_offsets_[s + 1])`.
+    std::vector<std::size_t> closure_offsets_;
 
-    Accept_states_t accept_states_;
+    std::vector<State_t> closure_states_;
 };
 
 } // namespace lexer::nfa
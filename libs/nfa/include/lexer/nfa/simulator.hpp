@@ -37,20 +37,24 @@ public:
             return {std::nullopt, 0};
         }
 
-        auto states{Nfa::epsilon_closure(nfa, {nfa.init_state()})};
+        auto states{Nfa::epsilon_closure(nfa, State_set{nfa.init_state()})};
 
         Result_t result{Nfa::has_accept_token(nfa, states), 0};
 
-        for (Iterator current = begin; current != end && !states.empty(); ++current)
+        std::size_t length{0};
+
+        for (Iterator current = begin; current != end; ++current)
         {
             if (states = Nfa::advance(nfa, states, *current); states.empty())
             {
-                continue;
+                break;
             }
 
+            ++length;
+
             if (const auto token = Nfa::has_accept_token(nfa, states); token)
             {
-                result = {token, std::distance(begin, current) + 1};
+                result = {token, length};
             }
         }
 
@@ -0,0 +1,131 @@
+#ifndef LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_STATE_SET_HPP
+#define LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_STATE_SET_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace lexer::nfa
+{
+/**
+ * @brief Immutable set of NFA states, stored as a sorted vector with a cached hash.
+ *
+ * Subsets reached during simulation and subset construction are usually small compared to the NFA, so a sorted vector
+ * is both more compact and faster to compare than a node-based set. The hash is computed once, while the set is built,
+ * so using it as a key never rehashes its elements. Hash and Equal also accept sorted spans of distinct states, so a
+ * candidate set can be looked up without being copied into a State_set.
+ */
+class State_set
+{
+public:
+    /**
+     * @brief Type representing an NFA state identifier.
+     */
+    using State_t = std::size_t;
+
+    /**
+     * @brief Iterator over the states, in ascending order.
+     */
+    using const_iterator = std::vector<State_t>::const_iterator;
+
+    /**
+     * @brief Transparent hash functor returning the cached hash of a set.
+     */
+    struct Hash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(const State_set& states) const noexcept { return states.hash(); }
+
+        /**
+         * @brief Hashes sorted, distinct states as a State_set holding them would.
+         */
+        std::size_t operator()(std::span<const State_t> states) const noexcept;
+    };
+
+    /**
+     * @brief Transparent equality functor comparing sets with sorted spans of distinct states.
+     */
+    struct Equal
+    {
+        using is_transparent = void;
+
+        bool operator()(const State_set& lhs, const State_set& rhs) const noexcept { return lhs == rhs; }
+
+        bool operator()(const State_set& lhs, std::span<const State_t> rhs) const noexcept;
+
+        bool operator()(std::span<const State_t> lhs, const State_set& rhs) const noexcept { return (*this)(rhs, lhs); }
+    };
+
+    /**
+     * @brief Constructs an empty set.
+     */
+    State_set() = default;
+
+    /**
+     * @brief Constructs a set from states in any order, possibly repeated.
+     * @param states The states.
+     */
+    explicit State_set(std::vector<State_t> states);
+
+    /**
+     * @brief Constructs a set from a list of states.
+     * @param states The states.
+     */
+    State_set(std::initializer_list<State_t> states);
+
+    /**
+     * @brief Returns an iterator to the lowest state.
+     * @return The iterator.
+     */
+    [[nodiscard]] const_iterator begin() const noexcept { return states_.begin(); }
+
+    /**
+     * @brief Returns the past-the-end iterator.
+     * @return The iterator.
+     */
+    [[nodiscard]] const_iterator end() const noexcept { return states_.end(); }
+
+    /**
+     * @brief Returns the number of states.
+     * @return The number of states.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return states_.size(); }
+
+    /**
+     * @brief Checks if the set is empty.
+     * @return True if the set holds no state.
+     */
+    [[nodiscard]] bool empty() const noexcept { return states_.empty(); }
+
+    /**
+     * @brief Checks if the set contains a state.
+     * @param state The state to look up.
+     * @return True if the state belongs to the set.
+     */
+    [[nodiscard]] bool contains(State_t state) const noexcept;
+
+    /**
+     * @brief Returns the hash of the set.
+     * @return The hash, computed on construction.
+     */
+    [[nodiscard]] std::size_t hash() const noexcept { return hash_; }
+
+    /**
+     * @brief Equality comparison operator, comparing the cached hashes first.
+     */
+    friend bool operator==(const State_set& lhs, const State_set& rhs) noexcept
+    {
+        return lhs.hash_ == rhs.hash_ && lhs.states_ == rhs.states_;
+    }
+
+private:
+    std::vector<State_t> states_;
+
+    std::size_t hash_{0};
+};
+
+} // namespace lexer::nfa
+
+#endif // LEXER_LIBS_NFA_INCLUDE_LEXER_NFA_STATE_SET_HPP
@@ -9,8 +9,8 @@ Builder::Builder() : init_state_{0}, next_state_{1}
 {}
 
 Builder::Builder(
-        const Nfa::State_t init_state, const Nfa::State_t next_state, Nfa::Transitions_t transitions,
-        Nfa::Accept_states_t accept_states)
+        const Nfa::State_t init_state, const Nfa::State_t next_state, Transitions_t transitions,
+        Accept_states_t accept_states)
     : init_state_{init_state}
     , next_state_{next_state}
     , transitions_{std::move(transitions)}
@@ -27,12 +27,12 @@ Nfa::State_t Builder::next_state() noexcept
     return next_state_++;
 }
 
-const Nfa::Transitions_t& Builder::transitions() const noexcept
+const Builder::Transitions_t& Builder::transitions() const noexcept
 {
     return transitions_;
 }
 
-const Nfa::Accept_states_t& Builder::accept_states() const noexcept
+const Builder::Accept_states_t& Builder::accept_states() const noexcept
 {
     return accept_states_;
 }
@@ -65,7 +65,19 @@ Builder& Builder::add_accept_state(const Nfa::State_t accept_state, const Token&
     return *this;
 }
 
-Builder& Builder::set_accept_states(Nfa::Accept_states_t accept_states)
+Builder& Builder::add_accept_state_by_priority(const Nfa::State_t accept_state, const std::optional<Token>& token)
+{
+    const auto [iterator, inserted]{accept_states_.try_emplace(accept_state, token)};
+
+    if (!inserted && token && iterator->second && *token < *iterator->second)
+    {
+        iterator->second = token;
+    }
+
+    return *this;
+}
+
+Builder& Builder::set_accept_states(Accept_states_t accept_states)
 {
     accept_states_ = std::move(accept_states);
 
@@ -78,14 +90,14 @@ Builder& Builder::set_accept_token(const Token& token)
 
     const auto view{std::views::keys(accept_states_) | std::views::transform(transform)};
 
-    Nfa::Accept_states_t accept_states{view.begin(), view.end()};
+    Accept_states_t accept_states{view.begin(), view.end()};
 
     return set_accept_states(std::move(accept_states));
 }
 
 Builder Builder::offset(const std::size_t offset) const
 {
-    Nfa::Transitions_t transitions;
+    Transitions_t transitions;
 
     for (const auto& [key, states] : transitions_)
     {
@@ -100,44 +112,57 @@ Builder Builder::offset(const std::size_t offset) const
 
     const auto view{accept_states_ | std::views::transform(transform)};
 
-    Nfa::Accept_states_t accept_states{view.begin(), view.end()};
+    Accept_states_t accept_states{view.begin(), view.end()};
 
     return {init_state_ + offset, next_state_ + offset, std::move(transitions), std::move(accept_states)};
 }
 
-Builder Builder::append(const Builder& other) const
+Builder Builder::append(const Builder& other) const&
+{
+    return Builder{*this}.append(other);
+}
+
+Builder Builder::append(const Builder& other) &&
 {
-    const auto offset_nfa{other.offset(next_state_)};
+    // Appending a Builder to itself would read the maps being moved from and written to, so a copy is appended.
+    if (&other == this)
+    {
+        return std::move(*this).append(Builder{other});
+    }
 
-    Builder nfa{init_state_, offset_nfa.next_state_, transitions_, accept_states_};
+    auto accept_states{std::move(accept_states_)};
 
-    // Add ε transition from current accept states to offset initial state.
-    std::ranges::for_each(std::views::keys(nfa.accept_states_), [&nfa, &offset_nfa](const auto accept_state) {
-        nfa.add_epsilon_transition(accept_state, offset_nfa.init_state_);
-    });
+    accept_states_.clear();
 
-    nfa.transitions_.insert(offset_nfa.transitions_.begin(), offset_nfa.transitions_.end());
+    const auto offset{insert(other)};
 
-    // Current accept states are replaced by ε transitions.
-    nfa.accept_states_ = offset_nfa.accept_states_;
+    // Current accept states are replaced by ε transitions to the offset initial state.
+    std::ranges::for_each(std::views::keys(accept_states), [this, &other, offset](const auto accept_state) {
+        add_epsilon_transition(accept_state, other.init_state_ + offset);
+    });
 
-    return nfa;
+    return std::move(*this);
 }
 
-Builder Builder::merge(const Builder& other) const
+Builder Builder::merge(const Builder& other) const&
 {
-    const auto offset_nfa{other.offset(next_state_)};
-
-    Builder nfa{init_state_, offset_nfa.next_state_, transitions_, accept_states_};
+    return Builder{*this}.merge(other);
+}
 
-    // Add ε transition between the initial states.
-    nfa.add_epsilon_transition(nfa.init_state_, offset_nfa.init_state_);
+Builder Builder::merge(const Builder& other) &&
+{
+    // Merging a Builder into itself would read the maps being written to, so a copy is merged.
+    if (&other == this)
+    {
+        return std::move(*this).merge(Builder{other});
+    }
 
-    nfa.transitions_.insert(offset_nfa.transitions_.begin(), offset_nfa.transitions_.end());
+    const auto offset{insert(other)};
 
-    nfa.accept_states_.insert(offset_nfa.accept_states_.begin(), offset_nfa.accept_states_.end());
+    // Add ε transition between the initial states.
+    add_epsilon_transition(init_state_, other.init_state_ + offset);
 
-    return nfa;
+    return std::move(*this);
 }
 
 Nfa Builder::build() const
@@ -145,4 +170,26 @@ Nfa Builder::build() const
     return {init_state_, transitions_, accept_states_};
 }
 
+Nfa::State_t Builder::insert(const Builder& other)
+{
+    const auto offset{next_state_};
+
+    for (const auto& [key, states] : other.transitions_)
+    {
+        const auto view{states | std::views::transform([offset](const auto state) { return state + offset; })};
+
+        const auto& [state, transition]{key};
+
+        transitions_[{state + offset, transition}].insert(view.begin(), view.end());
+    }
+
+    std::ranges::for_each(other.accept_states_, [this, offset](const auto& pair) {
+        accept_states_.emplace(pair.first + offset, pair.second);
+    });
+
+    next_state_ = other.next_state_ + offset;
+
+    return offset;
+}
+
 } // namespace lexer::nfa
@@ -12,9 +12,17 @@ bool Epsilon::operator==(const Epsilon&) const noexcept
 Label::Label(const Epsilon e) noexcept : variant_{e}
 {}
 
-Label::Label(const Symbol_t s) noexcept : variant_{s}
+Label::Label(const Symbol_t s) noexcept : variant_{Range{s, s}}
 {}
 
+Label::Label(const Symbol_t first, const Symbol_t last) : variant_{Range{first, last}}
+{
+    if (first > last)
+    {
+        throw std::invalid_argument("Label range first symbol is greater than its last symbol");
+    }
+}
+
 Label Label::epsilon() noexcept
 {
     return Label{Epsilon{}};
@@ -22,7 +30,7 @@ Label Label::epsilon() noexcept
 
 bool Label::is_symbol() const noexcept
 {
-    return std::holds_alternative<Symbol_t>(variant_);
+    return std::holds_alternative<Range>(variant_);
 }
 
 bool Label::is_epsilon() const noexcept
@@ -30,9 +38,26 @@ bool Label::is_epsilon() const noexcept
     return std::holds_alternative<Epsilon>(variant_);
 }
 
+Label::Symbol_t Label::first() const
+{
+    return std::get<Range>(variant_).first;
+}
+
+Label::Symbol_t Label::last() const
+{
+    return std::get<Range>(variant_).last;
+}
+
 Label::Symbol_t Label::symbol() const
 {
-    return std::get<Symbol_t>(variant_);
+    return first();
+}
+
+bool Label::contains(const Symbol_t symbol) const noexcept
+{
+    const auto* range{std::get_if<Range>(&variant_)};
+
+    return range != nullptr && range->first <= symbol && symbol <= range->last;
 }
 
 const Label::Variant_t& Label::variant() const noexcept
@@ -2,101 +2,315 @@
 
 #include <algorithm>
 #include <boost/container_hash/hash.hpp>
-#include <queue>
+#include <iterator>
+#include <numeric>
 #include <ranges>
+#include <tuple>
+#include <vector>
 
 namespace lexer::nfa
 {
-std::size_t Nfa::Hash::operator()(const Key_t& key) const noexcept
+std::size_t Nfa::Map_hash::operator()(const Map_key_t& key) const noexcept
 {
     std::size_t seed{};
     return boost::hash_combine(seed, key.first), boost::hash_combine(seed, std::hash<Label>{}(key.second)), seed;
 }
 
-Nfa::Nfa(const State_t init_state, Transitions_t transitions, Accept_states_t accept_states)
-    : init_state_{init_state}, transitions_{std::move(transitions)}, accept_states_{std::move(accept_states)}
-{}
+Nfa::Nfa(const State_t init_state, const Map_transitions_t& transitions, const Map_accept_states_t& accept_states)
+    : init_state_{init_state}
+    , size_{init_state + 1}
+{
+    const auto grow{[this](const auto state) { size_ = std::max(size_, state + 1); }};
+
+    for (const auto& [key, states] : transitions)
+    {
+        grow(key.first);
+
+        std::ranges::for_each(states, grow);
+    }
+
+    std::ranges::for_each(std::views::keys(accept_states), grow);
+
+    edge_offsets_.assign(size_ + 1, 0);
+
+    epsilon_offsets_.assign(size_ + 1, 0);
+
+    // Count the edges of each state, turn the counts into offsets, then fill each row from its end.
+    for (const auto& [key, states] : transitions)
+    {
+        (key.second.is_epsilon() ? epsilon_offsets_ : edge_offsets_)[key.first + 1] += states.size();
+    }
+
+    std::partial_sum(edge_offsets_.begin(), edge_offsets_.end(), edge_offsets_.begin());
+
+    std::partial_sum(epsilon_offsets_.begin(), epsilon_offsets_.end(), epsilon_offsets_.begin());
+
+    edges_.resize(edge_offsets_.back());
+
+    epsilon_edges_.resize(epsilon_offsets_.back());
+
+    auto edge_ends{std::vector(edge_offsets_.begin() + 1, edge_offsets_.end())};
+
+    auto epsilon_ends{std::vector(epsilon_offsets_.begin() + 1, epsilon_offsets_.end())};
+
+    for (const auto& [key, states] : transitions)
+    {
+        const auto& [from, label]{key};
+
+        for (const auto to : states)
+        {
+            if (label.is_epsilon())
+            {
+                epsilon_edges_[--epsilon_ends[from]] = to;
+            }
+            else
+            {
+                edges_[--edge_ends[from]] = {label.first(), label.last(), to};
+            }
+        }
+    }
+
+    const auto order{[](const Edge& edge) {
+        return std::tuple{edge.first, edge.last, edge.to};
+    }};
+
+    for (State_t state{0}; state < size_; ++state)
+    {
+        std::ranges::sort(
+                edges_.begin() + static_cast<std::ptrdiff_t>(edge_offsets_[state]),
+                edges_.begin() + static_cast<std::ptrdiff_t>(edge_offsets_[state + 1]), {}, order);
+
+        std::ranges::sort(
+                epsilon_edges_.begin() + static_cast<std::ptrdiff_t>(epsilon_offsets_[state]),
+                epsilon_edges_.begin() + static_cast<std::ptrdiff_t>(epsilon_offsets_[state + 1]));
+    }
+
+    accept_tokens_.resize(size_);
+
+    std::ranges::for_each(accept_states, [this](const auto& pair) {
+        accepting_states_.push_back(pair.first);
+        accept_tokens_[pair.first] = pair.second;
+    });
+
+    std::ranges::sort(accepting_states_);
+}
 
 Nfa::State_t Nfa::init_state() const noexcept
 {
     return init_state_;
 }
 
-const Nfa::Transitions_t& Nfa::transitions() const noexcept
+Nfa::Map_transitions_t Nfa::transitions() const
 {
-    return transitions_;
+    Map_transitions_t transitions;
+
+    for (State_t state{0}; state < size_; ++state)
+    {
+        std::ranges::for_each(edges(state), [&transitions, state](const auto& edge) {
+            transitions[{state, Label{edge.first, edge.last}}].insert(edge.to);
+        });
+
+        std::ranges::for_each(epsilon_edges(state), [&transitions, state](const auto to) {
+            transitions[{state, Label::epsilon()}].insert(to);
+        });
+    }
+
+    return transitions;
 }
 
-const Nfa::Accept_states_t& Nfa::accept_states() const noexcept
+Nfa::Map_accept_states_t Nfa::accept_states() const
 {
-    return accept_states_;
+    Map_accept_states_t accept_states;
+
+    std::ranges::for_each(accepting_states_, [this, &accept_states](const auto state) {
+        accept_states.emplace(state, accept_tokens_[state]);
+    });
+
+    return accept_states;
 }
 
-Nfa::States_t Nfa::epsilon_closure(const Nfa& nfa, const States_t& states)
+std::span<const Nfa::State_t> Nfa::accepting_states() const noexcept
 {
-    auto result{states};
+    return accepting_states_;
+}
 
-    std::queue queue{states.begin(), states.end()};
+std::size_t Nfa::size() const noexcept
+{
+    return size_;
+}
+
+std::span<const Nfa::Edge> Nfa::edges(const State_t state) const noexcept
+{
+    return std::span{edges_}.subspan(edge_offsets_[state], edge_offsets_[state + 1] - edge_offsets_[state]);
+}
+
+std::span<const Nfa::State_t> Nfa::epsilon_edges(const State_t state) const noexcept
+{
+    return std::span{epsilon_edges_}.subspan(
+            epsilon_offsets_[state], epsilon_offsets_[state + 1] - epsilon_offsets_[state]);
+}
+
+const std::optional<Token>& Nfa::accept_token(const State_t state) const noexcept
+{
+    return accept_tokens_[state];
+}
 
-    while (!queue.empty())
+Nfa& Nfa::precompute_closures()
+{
+    closure_offsets_.assign(1, 0);
+
+    closure_states_.clear();
+
+    std::vector<bool> marked(size_);
+
+    std::vector<State_t> stack;
+
+    std::vector<State_t> closure;
+
+    for (State_t state{0}; state < size_; ++state)
     {
-        const std::pair transition{queue.front(), Label::epsilon()};
+        marked[state] = true;
 
-        queue.pop();
+        stack.push_back(state);
 
-        const auto filter{[&nfa](const auto key) { return nfa.transitions().contains(key); }};
+        closure.push_back(state);
 
-        const auto transform{[&nfa](const auto key) { return nfa.transitions().at(key); }};
+        walk_epsilon(stack, marked, closure);
 
-        auto view{
-                std::views::single(transition) | std::views::filter(filter) | std::views::transform(transform) |
-                std::views::join};
+        std::ranges::sort(closure);
 
-        std::ranges::for_each(view, [&result, &queue](const auto state) {
-            if (result.insert(state).second)
-            {
-                queue.push(state);
-            }
-        });
+        std::ranges::for_each(closure, [&marked](const auto reached) { marked[reached] = false; });
+
+        closure_states_.insert(closure_states_.end(), closure.begin(), closure.end());
+
+        closure_offsets_.push_back(closure_states_.size());
+
+        closure.clear();
     }
 
-    return result;
+    return *this;
+}
+
+bool Nfa::has_closures() const noexcept
+{
+    return !closure_offsets_.empty();
+}
+
+std::span<const Nfa::State_t> Nfa::closure(const State_t state) const noexcept
+{
+    return std::span{closure_states_}.subspan(
+            closure_offsets_[state], closure_offsets_[state + 1] - closure_offsets_[state]);
+}
+
+State_set Nfa::epsilon_closure(const Nfa& nfa, const State_set& states)
+{
+    std::vector<bool> marked(nfa.size());
+
+    return epsilon_closure(nfa, states, marked);
+}
+
+State_set Nfa::epsilon_closure(const Nfa& nfa, const State_set& states, std::vector<bool>& marked)
+{
+    std::vector<State_t> result;
+
+    epsilon_closure(nfa, std::span{states.begin(), states.end()}, marked, result);
+
+    return State_set{std::move(result)};
 }
 
-Nfa::States_t Nfa::advance(const Nfa& nfa, const States_t& states, const char symbol)
+void Nfa::epsilon_closure(
+        const Nfa& nfa, const std::span<const State_t> states, std::vector<bool>& marked, std::vector<State_t>& result)
 {
-    const auto filter{[&nfa, symbol](const auto& state) { return nfa.transitions().contains({state, Label{symbol}}); }};
+    result.clear();
 
-    const auto transform{[&nfa, symbol](const auto& state) { return nfa.transitions().at({state, Label{symbol}}); }};
+    const auto reach{[&marked, &result](const auto state) {
+        if (!marked[state])
+        {
+            marked[state] = true;
+            result.push_back(state);
+        }
+    }};
 
-    States_t result;
+    if (nfa.has_closures())
+    {
+        std::ranges::for_each(states, [&nfa, &reach](const auto state) {
+            std::ranges::for_each(nfa.closure(state), reach);
+        });
+    }
+    else
+    {
+        std::ranges::for_each(states, reach);
+
+        std::vector<State_t> stack{result};
 
-    const auto insert{[&result](const auto& elements) { result.insert(elements.begin(), elements.end()); }};
+        nfa.walk_epsilon(stack, marked, result);
+    }
 
-    std::ranges::for_each(states | std::views::filter(filter) | std::views::transform(transform), insert);
+    // The marked states are exactly the result, so clearing them restores the buffer for the next call.
+    std::ranges::for_each(result, [&marked](const auto state) { marked[state] = false; });
 
-    return epsilon_closure(nfa, result);
+    std::ranges::sort(result);
 }
 
-std::optional<Token> Nfa::has_accept_token(const Nfa& nfa, const States_t& states)
+State_set Nfa::advance(const Nfa& nfa, const State_set& states, const Label::Symbol_t symbol)
 {
-    const auto has_state{[&nfa](const auto state) { return nfa.accept_states().contains(state); }};
+    return epsilon_closure(nfa, step(nfa, states, symbol));
+}
 
-    const auto has_token{[&nfa](const auto state) { return nfa.accept_states().at(state).has_value(); }};
+State_set Nfa::step(const Nfa& nfa, const State_set& states, const Label::Symbol_t symbol)
+{
+    std::vector<State_t> result;
 
-    const auto get_token{[&nfa](const auto state) { return nfa.accept_states().at(state).value(); }};
+    // Edges are ordered by their first symbol, so the scan of a row stops at the first range starting above the symbol.
+    std::ranges::for_each(states, [&nfa, &result, symbol](const auto state) {
+        for (const auto& edge : nfa.edges(state))
+        {
+            if (edge.first > symbol)
+            {
+                break;
+            }
 
-    auto view{
-            states | std::views::filter(has_state) | std::views::filter(has_token) | std::views::transform(get_token)};
+            if (symbol <= edge.last)
+            {
+                result.push_back(edge.to);
+            }
+        }
+    });
 
-    const auto comparator{[](const auto& lhs, const auto& rhs) { return lhs < rhs; }};
+    return State_set{std::move(result)};
+}
 
-    if (auto iterator = std::ranges::min_element(view, comparator); iterator != view.end())
+std::optional<Token> Nfa::has_accept_token(const Nfa& nfa, const State_set& states)
+{
+    std::optional<Token> result;
+
+    std::ranges::for_each(states, [&nfa, &result](const auto state) {
+        if (const auto& token = nfa.accept_token(state); token && (!result || *token < *result))
+        {
+            result = token;
+        }
+    });
+
+    return result;
+}
+
+void Nfa::walk_epsilon(std::vector<State_t>& stack, std::vector<bool>& marked, std::vector<State_t>& result) const
+{
+    while (!stack.empty())
     {
-        return {*iterator};
-    }
+        const auto state{stack.back()};
+
+        stack.pop_back();
 
-    return std::nullopt;
+        std::ranges::for_each(epsilon_edges(state), [&marked, &result, &stack](const auto next) {
+            if (!marked[next])
+            {
+                marked[next] = true;
+                result.push_back(next);
+                stack.push_back(next);
+            }
+        });
+    }
 }
 
 } // namespace lexer::nfa
@@ -0,0 +1,35 @@
+#include "lexer/nfa/state_set.hpp"
+
+#include <algorithm>
+#include <boost/container_hash/hash.hpp>
+
+namespace lexer::nfa
+{
+State_set::State_set(std::vector<State_t> states) : states_{std::move(states)}
+{
+    std::ranges::sort(states_);
+
+    states_.erase(std::ranges::unique(states_).begin(), states_.end());
+
+    hash_ = boost::hash_range(states_.begin(), states_.end());
+}
+
+State_set::State_set(const std::initializer_list<State_t> states) : State_set{std::vector<State_t>{states}}
+{}
+
+std::size_t State_set::Hash::operator()(const std::span<const State_t> states) const noexcept
+{
+    return boost::hash_range(states.begin(), states.end());
+}
+
+bool State_set::Equal::operator()(const State_set& lhs, const std::span<const State_t> rhs) const noexcept
+{
+    return std::ranges::equal(lhs.states_, rhs);
+}
+
+bool State_set::contains(const State_t state) const noexcept
+{
+    return std::ranges::binary_search(states_, state);
+}
+
+} // namespace lexer::nfa
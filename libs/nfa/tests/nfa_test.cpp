@@ -2,9 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <list>
 #include <sstream>
+#include <vector>
 
 #include "lexer/nfa/builder.hpp"
 #include "lexer/nfa/simulator.hpp"
@@ -371,3 +375,287 @@ TEST_F(Nfa_test, Loop_plus_a)
     EXPECT_EQ(Simulator::run(result, ""), Result_t(std::nullopt, 0));
     EXPECT_EQ(Simulator::run(result, "b"), Result_t(std::nullopt, 0));
 }
+
+TEST_F(Nfa_test, Single_pass_input)
+{
+    nfa::Builder nfa;
+
+    const auto q0{nfa.init_state()};
+    const auto q1{nfa.next_state()};
+
+    const Token token{1, 1};
+
+    nfa.add_accept_state(q1, token);
+
+    nfa.add_transition(q0, nfa::Label('a'), q1);
+    nfa.add_transition(q1, nfa::Label('a'), q1);
+
+    const auto result{nfa.build()};
+
+    using Result_t = Simulator::Result_t;
+
+    const std::list<char> list{'a', 'a', 'b'};
+
+    EXPECT_EQ(Simulator::run(result, list), Result_t(token, 2));
+
+    std::istringstream stream{"aab"};
+
+    EXPECT_EQ(
+            Simulator::run(result, std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}),
+            Result_t(token, 2));
+
+    // The symbol on which the NFA dies is left in the input.
+    EXPECT_EQ(stream.get(), 'b');
+}
+
+TEST_F(Nfa_test, Merge_in_place)
+{
+    nfa::Builder a;
+
+    const auto a1{a.next_state()};
+
+    a.add_transition(a.init_state(), nfa::Label('a'), a1);
+    a.add_accept_state(a1, Token{1, 1});
+
+    nfa::Builder b;
+
+    const auto b1{b.next_state()};
+    const auto b2{b.next_state()};
+
+    b.add_transition(b.init_state(), nfa::Label('b'), b1);
+    b.add_epsilon_transition(b1, b2);
+    b.add_accept_state(b2, Token{2, 1});
+
+    for (const auto& [copied, moved] : {std::pair{a.merge(b), nfa::Builder{a}.merge(b)},
+                                        std::pair{a.append(b), nfa::Builder{a}.append(b)}})
+    {
+        EXPECT_EQ(copied.init_state(), moved.init_state());
+        EXPECT_EQ(copied.transitions(), moved.transitions());
+        EXPECT_EQ(copied.accept_states(), moved.accept_states());
+        EXPECT_EQ(nfa::Builder{copied}.next_state(), nfa::Builder{moved}.next_state());
+    }
+
+    using Result_t = Simulator::Result_t;
+
+    const auto merged{nfa::Builder{a}.merge(b).build()};
+
+    EXPECT_EQ(Simulator::run(merged, "a"), Result_t(Token(1, 1), 1));
+    EXPECT_EQ(Simulator::run(merged, "b"), Result_t(Token(2, 1), 1));
+
+    const auto appended{nfa::Builder{a}.append(b).build()};
+
+    EXPECT_EQ(Simulator::run(appended, "ab"), Result_t(Token(2, 1), 2));
+    EXPECT_EQ(Simulator::run(appended, "a"), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Nfa_test, Merge_into_itself)
+{
+    nfa::Builder a;
+
+    const auto a1{a.next_state()};
+
+    a.add_transition(a.init_state(), nfa::Label('a'), a1);
+    a.add_accept_state(a1, Token{1, 1});
+
+    auto self{a};
+
+    const auto merged{std::move(self).merge(self)};
+
+    EXPECT_EQ(merged.accept_states().size(), 2);
+    EXPECT_EQ(merged.transitions(), a.merge(a).transitions());
+
+    auto twice{a};
+
+    const auto appended{std::move(twice).append(twice).build()};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(appended, "a"), Result_t(std::nullopt, 0));
+    EXPECT_EQ(Simulator::run(appended, "aa"), Result_t(Token(1, 1), 2));
+}
+
+TEST_F(Nfa_test, Accept_state_by_priority)
+{
+    nfa::Builder builder;
+
+    const auto state{builder.init_state()};
+
+    builder.add_accept_state_by_priority(state, Token{1, 2});
+    EXPECT_EQ(builder.accept_states().at(state), Token(1, 2));
+
+    builder.add_accept_state_by_priority(state, Token{2, 1});
+    EXPECT_EQ(builder.accept_states().at(state), Token(2, 1));
+
+    builder.add_accept_state_by_priority(state, Token{3, 3});
+    builder.add_accept_state_by_priority(state, std::nullopt);
+    EXPECT_EQ(builder.accept_states().at(state), Token(2, 1));
+
+    const auto unset{builder.next_state()};
+
+    builder.add_accept_state_by_priority(unset, std::nullopt);
+    builder.add_accept_state_by_priority(unset, Token{4, 0});
+    EXPECT_EQ(builder.accept_states().at(unset), std::nullopt);
+}
+
+TEST_F(Nfa_test, Precompute_closures)
+{
+    nfa::Builder nfa;
+
+    // q0 -ε-> q1 -ε-> q2 -a-> q3 -ε-> q1, with an epsilon cycle between q4 and q5.
+    const auto q0{nfa.init_state()};
+    const auto q1{nfa.next_state()};
+    const auto q2{nfa.next_state()};
+    const auto q3{nfa.next_state()};
+    const auto q4{nfa.next_state()};
+    const auto q5{nfa.next_state()};
+
+    const Token token{1, 1};
+
+    nfa.add_accept_state(q3, token);
+
+    nfa.add_epsilon_transition(q0, q1);
+    nfa.add_epsilon_transition(q1, q2);
+    nfa.add_transition(q2, nfa::Label('a'), q3);
+    nfa.add_epsilon_transition(q3, q1);
+    nfa.add_transition(q3, nfa::Label('b'), q4);
+    nfa.add_epsilon_transition(q4, q5);
+    nfa.add_epsilon_transition(q5, q4);
+
+    const auto walked{nfa.build()};
+
+    auto precomputed{nfa.build()};
+
+    EXPECT_FALSE(precomputed.has_closures());
+
+    precomputed.precompute_closures();
+
+    ASSERT_TRUE(precomputed.has_closures());
+
+    const auto closure{[&precomputed](const auto state) {
+        const auto span{precomputed.closure(state)};
+
+        return std::vector(span.begin(), span.end());
+    }};
+
+    using States_t = std::vector<Nfa::State_t>;
+
+    EXPECT_EQ(closure(q0), (States_t{q0, q1, q2}));
+    EXPECT_EQ(closure(q2), (States_t{q2}));
+    EXPECT_EQ(closure(q3), (States_t{q1, q2, q3}));
+    EXPECT_EQ(closure(q4), (States_t{q4, q5}));
+
+    std::vector<bool> marked(walked.size());
+
+    for (const auto& states : {State_set{q0}, State_set{q3, q4}, State_set{q2, q5}})
+    {
+        EXPECT_EQ(Nfa::epsilon_closure(precomputed, states), Nfa::epsilon_closure(walked, states));
+
+        // A reused buffer yields the same closures and is left cleared.
+        EXPECT_EQ(Nfa::epsilon_closure(walked, states, marked), Nfa::epsilon_closure(walked, states));
+        EXPECT_EQ(Nfa::epsilon_closure(precomputed, states, marked), Nfa::epsilon_closure(walked, states));
+        EXPECT_EQ(std::ranges::count(marked, true), 0);
+    }
+
+    for (const std::string input : {"a", "aa", "ab", "aba", "b"})
+    {
+        EXPECT_EQ(Simulator::run(precomputed, input), Simulator::run(walked, input)) << input;
+    }
+}
+
+TEST_F(Nfa_test, Adjacency)
+{
+    nfa::Builder nfa;
+
+    const auto q0{nfa.init_state()};
+    const auto q1{nfa.next_state()};
+    const auto q2{nfa.next_state()};
+    const auto q3{nfa.next_state()};
+
+    const Token token{1, 1};
+
+    nfa.add_accept_state(q3, token);
+    nfa.add_accept_state(q2);
+
+    nfa.add_transition(q0, nfa::Label('b'), q2);
+    nfa.add_transition(q0, nfa::Label('\xFF'), q1);
+    nfa.add_transition(q0, nfa::Label('a'), q3);
+    nfa.add_transition(q0, nfa::Label('a'), q1);
+    nfa.add_epsilon_transition(q0, q3);
+    nfa.add_epsilon_transition(q0, q2);
+    nfa.add_epsilon_transition(q1, q3);
+
+    const auto result{nfa.build()};
+
+    ASSERT_EQ(result.size(), 4);
+
+    const auto edges{result.edges(q0)};
+
+    ASSERT_EQ(edges.size(), 4);
+
+    // Ordered by unsigned range, then destination.
+    EXPECT_EQ(edges[0].first, 'a');
+    EXPECT_EQ(edges[0].last, 'a');
+    EXPECT_EQ(edges[0].to, q1);
+    EXPECT_EQ(edges[1].first, 'a');
+    EXPECT_EQ(edges[1].to, q3);
+    EXPECT_EQ(edges[2].first, 'b');
+    EXPECT_EQ(edges[2].to, q2);
+    EXPECT_EQ(edges[3].first, 0xFF);
+    EXPECT_EQ(edges[3].to, q1);
+
+    EXPECT_TRUE(result.edges(q3).empty());
+
+    EXPECT_EQ(std::vector(result.epsilon_edges(q0).begin(), result.epsilon_edges(q0).end()),
+              (std::vector<Nfa::State_t>{q2, q3}));
+    EXPECT_EQ(result.epsilon_edges(q1).size(), 1);
+    EXPECT_TRUE(result.epsilon_edges(q2).empty());
+
+    EXPECT_EQ(result.accept_token(q3), token);
+    EXPECT_EQ(result.accept_token(q2), std::nullopt);
+    EXPECT_EQ(result.accept_token(q0), std::nullopt);
+
+    EXPECT_EQ(Nfa::step(result, State_set{q0}, 'a'), (State_set{q1, q3}));
+    EXPECT_EQ(Nfa::advance(result, State_set{q0}, '\xFF'), (State_set{q1, q3}));
+    EXPECT_TRUE(Nfa::step(result, State_set{q0}, 'c').empty());
+}
+
+TEST_F(Nfa_test, Range_labels)
+{
+    nfa::Builder nfa;
+
+    const auto q0{nfa.init_state()};
+    const auto q1{nfa.next_state()};
+    const auto q2{nfa.next_state()};
+
+    nfa.add_accept_state(q1);
+    nfa.add_accept_state(q2);
+
+    nfa.add_transition(q0, nfa::Label('a', 'z'), q1);
+    nfa.add_transition(q0, nfa::Label('x'), q2);
+    nfa.add_transition(q0, nfa::Label('\x80', '\xFF'), q2);
+
+    const auto result{nfa.build()};
+
+    const auto edges{result.edges(q0)};
+
+    ASSERT_EQ(edges.size(), 3);
+
+    EXPECT_EQ(edges[0].first, 'a');
+    EXPECT_EQ(edges[0].last, 'z');
+    EXPECT_EQ(edges[1].first, 'x');
+    EXPECT_EQ(edges[1].last, 'x');
+    EXPECT_EQ(edges[2].first, 0x80);
+    EXPECT_EQ(edges[2].last, 0xFF);
+
+    EXPECT_EQ(Nfa::step(result, State_set{q0}, 'a'), (State_set{q1}));
+    EXPECT_EQ(Nfa::step(result, State_set{q0}, 'x'), (State_set{q1, q2}));
+    EXPECT_EQ(Nfa::step(result, State_set{q0}, 'z'), (State_set{q1}));
+    EXPECT_EQ(Nfa::step(result, State_set{q0}, '\xC3'), (State_set{q2}));
+    EXPECT_TRUE(Nfa::step(result, State_set{q0}, '`').empty());
+    EXPECT_TRUE(Nfa::step(result, State_set{q0}, '{').empty());
+
+    EXPECT_TRUE(nfa::Label('a', 'z').contains('m'));
+    EXPECT_FALSE(nfa::Label('a', 'z').contains('A'));
+    EXPECT_FALSE(nfa::Label::epsilon().contains('a'));
+    EXPECT_THROW(nfa::Label('z', 'a'), std::invalid_argument);
+}
@@ -0,0 +1,57 @@
+#include "lexer/nfa/state_set.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+using namespace lexer::nfa;
+
+using State_set_test = testing::Test;
+
+TEST_F(State_set_test, Test_empty)
+{
+    const State_set states;
+
+    EXPECT_TRUE(states.empty());
+    EXPECT_EQ(states.size(), 0);
+    EXPECT_FALSE(states.contains(0));
+    EXPECT_EQ(states, State_set{});
+}
+
+TEST_F(State_set_test, Sorted_and_unique)
+{
+    const State_set states{std::vector<State_set::State_t>{5, 1, 3, 1, 5}};
+
+    EXPECT_EQ(states.size(), 3);
+    EXPECT_EQ(std::vector(states.begin(), states.end()), (std::vector<State_set::State_t>{1, 3, 5}));
+
+    EXPECT_TRUE(states.contains(3));
+    EXPECT_FALSE(states.contains(2));
+}
+
+TEST_F(State_set_test, Equality_and_hash)
+{
+    const State_set lhs{3, 1, 2};
+    const State_set rhs{2, 3, 1, 1};
+    const State_set other{1, 2};
+
+    EXPECT_EQ(lhs, rhs);
+    EXPECT_EQ(lhs.hash(), rhs.hash());
+    EXPECT_NE(lhs, other);
+
+    const std::unordered_set<State_set, State_set::Hash> interned{lhs, rhs, other};
+
+    EXPECT_EQ(interned.size(), 2);
+}
+
+TEST_F(State_set_test, Lookup_by_span)
+{
+    const std::unordered_set<State_set, State_set::Hash, State_set::Equal> interned{State_set{1, 2, 3}, State_set{4}};
+
+    const std::vector<State_set::State_t> present{1, 2, 3};
+    const std::vector<State_set::State_t> absent{1, 2};
+
+    EXPECT_EQ(State_set::Hash{}(std::span{present}), State_set(present).hash());
+    EXPECT_TRUE(interned.contains(std::span<const State_set::State_t>{present}));
+    EXPECT_FALSE(interned.contains(std::span<const State_set::State_t>{absent}));
+}
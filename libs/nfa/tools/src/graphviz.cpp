@@ -1,12 +1,49 @@
 #include "lexer/nfa/tools/graphviz.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <ranges>
 #include <stdexcept>
 
+namespace
+{
+/**
+ * Writes a symbol to a Graphviz label, escaping quotes, backslashes and non-printable bytes.
+ */
+void write_symbol(std::ostream& oss, const lexer::nfa::Label::Symbol_t symbol)
+{
+    switch (symbol)
+    {
+    case '\"':
+        oss << "\\\"";
+        break;
+    case '\\':
+        oss << "\\\\";
+        break;
+    case '\n':
+        oss << "\\n";
+        break;
+    case '\t':
+        oss << "\\t";
+        break;
+    default:
+        if (std::isprint(symbol))
+        {
+            oss << static_cast<char>(symbol);
+        }
+        else
+        {
+            oss << "\\x" << std::hex << std::uppercase << std::setfill('0') << std::setw(2)
+                << static_cast<unsigned>(symbol);
+        }
+    }
+}
+
+} // namespace
+
 namespace lexer::nfa::tools
 {
 void Graphviz::to_file(const Nfa& nfa, const std::filesystem::path& path)
@@ -39,8 +76,10 @@ std::string Graphviz::to_dot(const Nfa& nfa)
 
     const auto format_token{[](const auto token) { return token.has_value() ? std::to_string(token->id()) : "n/a"; }};
 
-    for (const auto& [state, token] : nfa.accept_states())
+    for (const auto state : nfa.accepting_states())
     {
+        const auto& token{nfa.accept_token(state)};
+
         oss << "    " << state << " [shape = doublecircle, label=\"" << state << " (" << format_token(token) << ")"
             << "\"];\n";
     }
@@ -48,12 +87,18 @@ std::string Graphviz::to_dot(const Nfa& nfa)
     oss << "    __start__ [shape = none, label=\"\"];\n";
     oss << "    __start__ -> " << nfa.init_state() << ";\n";
 
-    for (const auto& [key, states] : nfa.transitions())
+    const auto epsilon{create_label(Label::epsilon())};
+
+    for (Nfa::State_t from_state{0}; from_state < nfa.size(); ++from_state)
     {
-        const auto& [from_state, transition]{key};
+        std::ranges::for_each(nfa.edges(from_state), [&oss, from_state](const auto& edge) {
+            const Label transition{edge.first, edge.last};
+
+            oss << "    " << from_state << " -> " << edge.to << " [label = " << create_label(transition) << "];\n";
+        });
 
-        std::ranges::for_each(states, [&oss, from_state, transition](const auto& to_state) {
-            oss << "    " << from_state << " -> " << to_state << " [label = " << create_label(transition) << "];\n";
+        std::ranges::for_each(nfa.epsilon_edges(from_state), [&oss, &epsilon, from_state](const auto to_state) {
+            oss << "    " << from_state << " -> " << to_state << " [label = " << epsilon << "];\n";
         });
     }
 
@@ -73,30 +118,17 @@ std::string Graphviz::create_label(const Label& label)
 
     oss << '"';
 
-    switch (const auto symbol{label.symbol()})
+    if (label.first() == label.last())
     {
-    case '\"':
-        oss << "\\\"";
-        break;
-    case '\\':
-        oss << "\\\\";
-        break;
-    case '\n':
-        oss << "\\n";
-        break;
-    case '\t':
-        oss << "\\t";
-        break;
-    default:
-        if (isprint(symbol))
-        {
-            oss << symbol;
-        }
-        else
-        {
-            oss << "\\x" << std::hex << std::uppercase << std::setfill('0') << std::setw(2)
-                << (static_cast<unsigned char>(symbol) & 0xFF);
-        }
+        write_symbol(oss, label.first());
+    }
+    else
+    {
+        oss << '[';
+        write_symbol(oss, label.first());
+        oss << '-';
+        write_symbol(oss, label.last());
+        oss << ']';
     }
 
     oss << '"';
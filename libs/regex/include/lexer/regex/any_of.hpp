@@ -2,6 +2,7 @@
 #define LEXER_LIBS_REGEX_INCLUDE_ANY_HPP
 
 #include <memory>
+#include <vector>
 
 #include "lexer/regex/regex.hpp"
 #include "lexer/regex/set.hpp"
@@ -28,23 +29,39 @@ public:
         return std::shared_ptr<Any_of>(new Any_of(std::forward<T>(chars)));
     }
 
+    /**
+     * @brief Returns the matched set.
+     * @return Reference to the set of characters to match.
+     */
+    [[nodiscard]] const Set& set() const noexcept;
+
     Any_of(const Any_of&) = delete;
     Any_of& operator=(const Any_of&) = delete;
 
     Any_of(Any_of&&) = delete;
     Any_of& operator=(Any_of&&) = delete;
 
-    /**
-     * @brief Converts this regex node to an NFA builder.
-     * @return NFA builder representing this regex.
-     */
-    [[nodiscard]] nfa::Builder to_nfa() const override;
-
 private:
+    [[nodiscard]] nfa::Builder lower(Cache& cache) const override;
+
+    [[nodiscard]] Positions positions(Position_automaton& automaton) const override;
+
+    [[nodiscard]] bool equals(const Regex& other) const override;
+
+    [[nodiscard]] bool nullable(Derivatives& derivatives) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> derivative(Derivatives& derivatives,
+            const std::shared_ptr<const Regex>& self,
+            Set::Symbol_t symbol) const override;
+
+    [[nodiscard]] std::vector<Symbols> classes(Derivatives& derivatives) const override;
+
     template <typename T>
-    explicit Any_of(T&& chars) : set_{std::forward<T>(chars)}
+    explicit Any_of(T&& chars) : Any_of{Set{std::forward<T>(chars)}}
     {}
 
+    explicit Any_of(Set set);
+
     Set set_;
 };
 
@@ -60,6 +77,21 @@ std::shared_ptr<const Regex> any_of(T&& chars)
     return Any_of::create(std::forward<T>(chars));
 }
 
+/**
+ * @brief Helper function to create an Any_of regex node matching any byte outside a set of characters.
+ *
+ * The complement is compiled like any other set, into one transition per contiguous range of bytes.
+ *
+ * @tparam T Type convertible to Set.
+ * @param chars The set of characters to exclude.
+ * @return Shared pointer to the created Regex node.
+ */
+template <typename T>
+std::shared_ptr<const Regex> none_of(T&& chars)
+{
+    return Any_of::create(Set{std::forward<T>(chars)}.complement());
+}
+
 } // namespace lexer::regex
 
 #endif // LEXER_LIBS_REGEX_INCLUDE_ANY_HPP
@@ -0,0 +1,40 @@
+#ifndef LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_CACHE_HPP
+#define LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_CACHE_HPP
+
+#include <unordered_map>
+
+#include "lexer/nfa/builder.hpp"
+#include "lexer/regex/regex.hpp"
+
+namespace lexer::regex
+{
+/**
+ * @brief Memo of regex nodes already lowered to NFA builders.
+ *
+ * Keyed on node structure: a node shared by several patterns, repeated by a bounded repetition or built again
+ * elsewhere is lowered once and then copied into each place it occurs, which only offsets its state numbers. A cache
+ * refers to the nodes it has seen, so it must not outlive them; it is meant to live for a single build.
+ */
+class Cache
+{
+public:
+    /**
+     * @brief Returns the NFA builder of a regex node, lowering it on first use.
+     * @param regex The regex node.
+     * @return Reference to the cached builder, valid for the lifetime of the cache.
+     */
+    [[nodiscard]] const nfa::Builder& to_nfa(const Regex& regex);
+
+    /**
+     * @brief Returns the number of distinct nodes lowered so far.
+     * @return The number of cached builders.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    std::unordered_map<const Regex*, nfa::Builder, Regex::Hash, Regex::Equal> builders_;
+};
+
+} // namespace lexer::regex
+
+#endif // LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_CACHE_HPP
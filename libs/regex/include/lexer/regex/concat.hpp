@@ -28,24 +28,45 @@ public:
         return std::shared_ptr<Concat>(new Concat(std::forward<Args>(args)...));
     }
 
+    /**
+     * @brief Returns the concatenated regexes.
+     * @return Reference to the regexes to match in sequence.
+     */
+    [[nodiscard]] const std::vector<std::shared_ptr<const Regex>>& regexes() const noexcept;
+
     Concat(const Concat&) = delete;
     Concat& operator=(const Concat&) = delete;
 
     Concat(Concat&&) = delete;
     Concat& operator=(Concat&&) = delete;
 
-    /**
-     * @brief Converts this regex node to an NFA builder.
-     * @return NFA builder representing this regex.
-     */
-    [[nodiscard]] nfa::Builder to_nfa() const override;
-
 private:
+    [[nodiscard]] nfa::Builder lower(Cache& cache) const override;
+
+    [[nodiscard]] Positions positions(Position_automaton& automaton) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> simplified(const std::shared_ptr<const Regex>& self) const override;
+
+    [[nodiscard]] bool equals(const Regex& other) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> interned(Interner& interner,
+            const std::shared_ptr<const Regex>& self) const override;
+
+    [[nodiscard]] bool nullable(Derivatives& derivatives) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> derivative(Derivatives& derivatives,
+            const std::shared_ptr<const Regex>& self,
+            Set::Symbol_t symbol) const override;
+
+    [[nodiscard]] std::vector<Symbols> classes(Derivatives& derivatives) const override;
+
     template <typename... Args>
         requires(sizeof...(Args) > 0)
-    explicit Concat(Args&&... args) : regexes_{std::forward<Args>(args)...}
+    explicit Concat(Args&&... args) : Concat{std::vector<std::shared_ptr<const Regex>>{std::forward<Args>(args)...}}
     {}
 
+    explicit Concat(std::vector<std::shared_ptr<const Regex>> regexes);
+
     std::vector<std::shared_ptr<const Regex>> regexes_;
 };
 
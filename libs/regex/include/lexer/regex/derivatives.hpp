@@ -0,0 +1,142 @@
+#ifndef LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_DERIVATIVES_HPP
+#define LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_DERIVATIVES_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lexer/regex/interner.hpp"
+#include "lexer/regex/regex.hpp"
+#include "lexer/regex/set.hpp"
+
+namespace lexer::regex
+{
+/**
+ * @brief Brzozowski derivatives of regexes, canonical up to similarity.
+ *
+ * The derivative of a regex with respect to a symbol matches the suffixes of the strings matched by the regex that
+ * start with the symbol. Derivatives are built through smart constructors that apply the similarity rules (the empty
+ * set absorbs concatenations and vanishes from choices, the empty text is the unit of concatenations, choices are
+ * flattened, sorted by structural hash and deduplicated), and interned, so that equivalent derivatives are usually the
+ * same node and repeated derivatives of a regex only reach finitely many nodes.
+ *
+ * The empty set is the set node without symbols, and the empty string the empty text node. Derivatives are taken per
+ * class of symbols that the regex cannot tell apart, following Owens, Reppy and Turon's derivative classes.
+ */
+class Derivatives
+{
+public:
+    /**
+     * @brief Type representing an input symbol.
+     */
+    using Symbol_t = Set::Symbol_t;
+
+    /**
+     * @brief Type representing a partition of the symbols into classes.
+     */
+    using Classes_t = std::vector<Symbols>;
+
+    /**
+     * @brief Constructs an empty derivative memo.
+     */
+    Derivatives();
+
+    /**
+     * @brief Returns the canonical node of a regex, through which its derivatives are memoized.
+     * @param regex The regex.
+     * @return The interned regex.
+     */
+    [[nodiscard]] std::shared_ptr<const Regex> intern(const std::shared_ptr<const Regex>& regex);
+
+    /**
+     * @brief Returns the derivative of a canonical regex with respect to a symbol.
+     * @param regex The regex, as returned by intern() or derive().
+     * @param symbol The symbol.
+     * @return The canonical derivative.
+     */
+    [[nodiscard]] std::shared_ptr<const Regex> derive(const std::shared_ptr<const Regex>& regex, Symbol_t symbol);
+
+    /**
+     * @brief Checks if a regex matches the empty string.
+     * @param regex The regex.
+     * @return True if the regex is nullable.
+     */
+    [[nodiscard]] bool nullable(const Regex& regex);
+
+    /**
+     * @brief Returns the regex matching nothing.
+     * @return The canonical empty set.
+     */
+    [[nodiscard]] const std::shared_ptr<const Regex>& empty() const noexcept;
+
+    /**
+     * @brief Returns the regex matching the empty string only.
+     * @return The canonical empty text.
+     */
+    [[nodiscard]] const std::shared_ptr<const Regex>& epsilon() const noexcept;
+
+    /**
+     * @brief Returns the canonical concatenation of two canonical regexes.
+     * @param lhs The regex matched first.
+     * @param rhs The regex matched next.
+     * @return The concatenation, simplified by similarity.
+     */
+    [[nodiscard]] std::shared_ptr<const Regex> concat(const std::shared_ptr<const Regex>& lhs,
+            const std::shared_ptr<const Regex>& rhs);
+
+    /**
+     * @brief Returns the canonical choice between canonical regexes.
+     * @param regexes The alternatives.
+     * @return The choice, simplified by similarity.
+     */
+    [[nodiscard]] std::shared_ptr<const Regex> choice(std::vector<std::shared_ptr<const Regex>> regexes);
+
+    /**
+     * @brief Returns the classes of symbols over which the derivative of a canonical regex is the same.
+     *
+     * The classes approximate the coarsest such partition from the sets and characters the regex starts with, so a
+     * DFA state only takes one derivative per class instead of one per symbol.
+     *
+     * @param regex The regex, as returned by intern() or derive().
+     * @return The non-empty, disjoint classes, covering all symbols.
+     */
+    [[nodiscard]] const Classes_t& classes(const Regex& regex);
+
+    /**
+     * @brief Returns the partition of the symbols into a set and its complement.
+     * @param symbols The set.
+     * @return The non-empty classes among the set and its complement.
+     */
+    [[nodiscard]] static Classes_t split(const Symbols& symbols);
+
+    /**
+     * @brief Returns the coarsest partition refining two partitions of the symbols.
+     * @param lhs The classes of the first partition.
+     * @param rhs The classes of the second partition.
+     * @return The non-empty intersections of a class of each partition.
+     */
+    [[nodiscard]] static Classes_t meet(const Classes_t& lhs, const Classes_t& rhs);
+
+private:
+    struct Hash
+    {
+        std::size_t operator()(const std::pair<const Regex*, Symbol_t>& key) const noexcept;
+    };
+
+    Interner interner_;
+
+    std::shared_ptr<const Regex> empty_;
+
+    std::shared_ptr<const Regex> epsilon_;
+
+    std::unordered_map<std::pair<const Regex*, Symbol_t>, std::shared_ptr<const Regex>, Hash> derivatives_;
+
+    std::unordered_map<const Regex*, bool> nullable_;
+
+    std::unordered_map<const Regex*, Classes_t> classes_;
+};
+
+} // namespace lexer::regex
+
+#endif // LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_DERIVATIVES_HPP
@@ -0,0 +1,40 @@
+#ifndef LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_INTERNER_HPP
+#define LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_INTERNER_HPP
+
+#include <memory>
+#include <unordered_set>
+
+#include "lexer/regex/regex.hpp"
+
+namespace lexer::regex
+{
+/**
+ * @brief Hash-consing table of regex nodes.
+ *
+ * Maps every regex to one canonical node per structure, operands included, so that structurally identical patterns
+ * built in different places end up as the same node. Interned patterns then share their sub-patterns, which a `Cache`
+ * recognizes by address without comparing them.
+ */
+class Interner
+{
+public:
+    /**
+     * @brief Returns the canonical node of a regex, interning its operands first.
+     * @param regex The regex to intern.
+     * @return The node interned for the structure of the regex, which is the regex itself if it was not known.
+     */
+    [[nodiscard]] std::shared_ptr<const Regex> intern(const std::shared_ptr<const Regex>& regex);
+
+    /**
+     * @brief Returns the number of distinct nodes interned so far.
+     * @return The number of canonical nodes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    std::unordered_set<std::shared_ptr<const Regex>, Regex::Hash, Regex::Equal> nodes_;
+};
+
+} // namespace lexer::regex
+
+#endif // LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_INTERNER_HPP
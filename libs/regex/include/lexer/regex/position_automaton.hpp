@@ -0,0 +1,126 @@
+#ifndef LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_POSITION_AUTOMATON_HPP
+#define LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_POSITION_AUTOMATON_HPP
+
+#include <optional>
+#include <vector>
+
+#include "lexer/nfa/builder.hpp"
+#include "lexer/regex/regex.hpp"
+#include "lexer/regex/set.hpp"
+
+namespace lexer::regex
+{
+/**
+ * @brief Positions of a regex within a position automaton, as computed by Glushkov's construction.
+ */
+struct Positions
+{
+    /**
+     * @brief Type representing a position, which is the NFA state entered by matching it.
+     */
+    using State_t = nfa::Nfa::State_t;
+
+    /**
+     * @brief Whether the regex matches the empty string.
+     */
+    bool nullable{true};
+
+    /**
+     * @brief Positions that can match the first symbol of the regex.
+     */
+    std::vector<State_t> first;
+
+    /**
+     * @brief Positions that can match the last symbol of the regex.
+     */
+    std::vector<State_t> last;
+};
+
+/**
+ * @brief Builder of an ε-free NFA by Glushkov's construction.
+ *
+ * Every occurrence of a symbol or set in a regex is a position, and gets one NFA state entered on the symbols it
+ * matches. Instead of wiring sub-automata together with ε transitions, each regex node computes its nullability and
+ * its first and last positions, and links the last positions of a sub-pattern directly to the positions that may
+ * follow them. The resulting NFA has one state per position plus the initial state, and no ε transition, so the subset
+ * construction never has to compute an ε closure.
+ */
+class Position_automaton
+{
+public:
+    /**
+     * @brief Adds the positions of a regex, unconnected to the initial state.
+     * @param regex The regex.
+     * @return The positions of the regex.
+     */
+    [[nodiscard]] Positions add(const Regex& regex);
+
+    /**
+     * @brief Adds a position matching any symbol of a set.
+     * @param set The symbols matched by the position.
+     * @return The positions of a regex made of this single position.
+     */
+    [[nodiscard]] Positions add(const Set& set);
+
+    /**
+     * @brief Links the last positions of a regex to the first positions of another one.
+     * @param lhs The positions of the regex matched first.
+     * @param rhs The positions of the regex matched next.
+     * @return The positions of the concatenation.
+     */
+    [[nodiscard]] Positions concat(Positions lhs, const Positions& rhs);
+
+    /**
+     * @brief Returns the positions of the alternation of two regexes.
+     * @param lhs The positions of the first alternative.
+     * @param rhs The positions of the second alternative.
+     * @return The positions of the alternation.
+     */
+    [[nodiscard]] static Positions choice(Positions lhs, const Positions& rhs);
+
+    /**
+     * @brief Links the last positions of a regex back to its first positions.
+     * @param positions The positions of the regex to repeat.
+     * @return The positions of one or more repetitions of the regex.
+     */
+    [[nodiscard]] Positions plus(Positions positions);
+
+    /**
+     * @brief Makes the initial state enter the first positions of a regex.
+     * @param positions The positions of the regex.
+     */
+    void start(const Positions& positions);
+
+    /**
+     * @brief Marks the last positions of a regex as accepting, and the initial state if the regex is nullable.
+     *
+     * When several nullable regexes accept in the initial state, the token with the highest priority is kept.
+     *
+     * @param positions The positions of the regex.
+     * @param token The token accepted, or std::nullopt to set it later.
+     */
+    void accept(const Positions& positions, const std::optional<nfa::Token>& token = std::nullopt);
+
+    /**
+     * @brief Returns the NFA built so far.
+     * @return Reference to the NFA builder.
+     */
+    [[nodiscard]] const nfa::Builder& builder() const noexcept;
+
+private:
+    /**
+     * @brief Adds transitions from positions into other positions, on the labels of the positions entered.
+     */
+    void follow(const std::vector<Positions::State_t>& from, const std::vector<Positions::State_t>& to);
+
+    nfa::Builder builder_;
+
+    /**
+     * @brief Labels entering each position, indexed by state.
+     */
+    std::vector<std::vector<nfa::Label>> labels_{1};
+};
+
+} // namespace lexer::regex
+
+#endif // LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_POSITION_AUTOMATON_HPP
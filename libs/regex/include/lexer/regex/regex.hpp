@@ -1,27 +1,186 @@
 #ifndef LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_REGEX_HPP
 #define LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_REGEX_HPP
 
+#include <memory>
+#include <vector>
+
 #include "lexer/nfa/builder.hpp"
+#include "lexer/regex/set.hpp"
 
 namespace lexer::regex
 {
+class Cache;
+class Derivatives;
+class Interner;
+class Position_automaton;
+struct Positions;
+
 /**
  * @brief Abstract base class for all regex nodes.
  *
- * Provides an interface for converting regex nodes to NFA builders.
+ * Provides an interface for converting regex nodes to NFA builders. Nodes are shared between patterns, so conversions
+ * go through a `Cache` that lowers each distinct node once. Nodes are immutable and compare structurally: their hash
+ * is computed once on construction from their kind, their content and the hashes of their operands.
  */
 class Regex
 {
 public:
+    /**
+     * @brief Hash functor returning the cached structural hash of a node held by any pointer.
+     */
+    struct Hash
+    {
+        template <typename Pointer>
+        std::size_t operator()(const Pointer& regex) const noexcept
+        {
+            return regex->hash();
+        }
+    };
+
+    /**
+     * @brief Equality functor comparing nodes held by any pointer structurally.
+     */
+    struct Equal
+    {
+        template <typename Pointer>
+        bool operator()(const Pointer& lhs, const Pointer& rhs) const
+        {
+            return *lhs == *rhs;
+        }
+    };
+
     virtual ~Regex() = default;
 
+    /**
+     * @brief Returns the structural hash of this node.
+     * @return The hash value, equal for structurally equal nodes.
+     */
+    [[nodiscard]] std::size_t hash() const noexcept;
+
+    /**
+     * @brief Structural equality comparison operator.
+     * @param other The node to compare with.
+     * @return True if both nodes are of the same kind, with equal content and structurally equal operands.
+     */
+    [[nodiscard]] bool operator==(const Regex& other) const;
+
     /**
      * @brief Converts this regex node to an NFA builder.
+     *
+     * Shared sub-patterns are lowered once for the whole conversion.
+     *
+     * @return NFA builder representing this regex.
+     */
+    [[nodiscard]] nfa::Builder to_nfa() const;
+
+    /**
+     * @brief Converts this regex node to an NFA builder, reusing the sub-patterns already lowered into a cache.
+     * @param cache The cache of lowered nodes, which records this node and its sub-patterns.
+     * @return NFA builder representing this regex.
+     */
+    [[nodiscard]] nfa::Builder to_nfa(Cache& cache) const;
+
+    /**
+     * @brief Converts this regex node to an ε-free NFA builder by Glushkov's construction.
+     *
+     * The NFA has one state per occurrence of a symbol or set in the regex, plus the initial state.
+     *
+     * @return NFA builder representing this regex.
+     */
+    [[nodiscard]] nfa::Builder to_position_automaton() const;
+
+protected:
+    /**
+     * @brief Constructs a node with its structural hash.
+     * @param hash The hash of the node, combining its kind, its content and the hashes of its operands.
+     */
+    explicit Regex(std::size_t hash) noexcept;
+
+    friend class Cache;
+    friend class Derivatives;
+    friend class Interner;
+    friend class Position_automaton;
+
+    friend std::shared_ptr<const Regex> simplify(const std::shared_ptr<const Regex>& regex);
+
+    /**
+     * @brief Lowers this regex node to an NFA builder, converting its sub-patterns through a cache.
+     * @param cache The cache of lowered nodes.
      * @return NFA builder representing this regex.
      */
-    [[nodiscard]] virtual nfa::Builder to_nfa() const = 0;
+    [[nodiscard]] virtual nfa::Builder lower(Cache& cache) const = 0;
+
+    /**
+     * @brief Adds the positions of this regex node to a position automaton.
+     * @param automaton The automaton to add the positions to.
+     * @return The positions of this regex.
+     */
+    [[nodiscard]] virtual Positions positions(Position_automaton& automaton) const = 0;
+
+    /**
+     * @brief Returns a simplified equivalent of this regex node, simplifying its sub-patterns first.
+     * @param self The shared pointer owning this node, returned when nothing can be simplified.
+     * @return The simplified regex.
+     */
+    [[nodiscard]] virtual std::shared_ptr<const Regex> simplified(const std::shared_ptr<const Regex>& self) const;
+
+    /**
+     * @brief Compares the content and operands of this node with another node of the same kind.
+     * @param other The node to compare with, whose dynamic type is the type of this node.
+     * @return True if both nodes are structurally equal.
+     */
+    [[nodiscard]] virtual bool equals(const Regex& other) const = 0;
+
+    /**
+     * @brief Returns this regex node over the canonical nodes of its operands.
+     * @param interner The interner to intern the operands with.
+     * @param self The shared pointer owning this node, returned when all operands are already canonical.
+     * @return The node to intern for this regex.
+     */
+    [[nodiscard]] virtual std::shared_ptr<const Regex> interned(Interner& interner,
+            const std::shared_ptr<const Regex>& self) const;
+
+    /**
+     * @brief Checks if this regex node matches the empty string.
+     * @param derivatives The memo through which the nullability of the operands is computed.
+     * @return True if the empty string is matched.
+     */
+    [[nodiscard]] virtual bool nullable(Derivatives& derivatives) const = 0;
+
+    /**
+     * @brief Returns the Brzozowski derivative of this canonical regex node with respect to a symbol.
+     * @param derivatives The memo through which the derivatives of the operands are computed and built.
+     * @param self The shared pointer owning this node.
+     * @param symbol The symbol.
+     * @return The regex matching the suffixes, after the symbol, of the strings matched by this regex.
+     */
+    [[nodiscard]] virtual std::shared_ptr<const Regex> derivative(Derivatives& derivatives,
+            const std::shared_ptr<const Regex>& self,
+            Set::Symbol_t symbol) const = 0;
+
+    /**
+     * @brief Partitions the symbols into classes over which the derivative of this regex node is the same.
+     * @param derivatives The memo through which the classes of the operands are computed.
+     * @return The non-empty, disjoint classes, covering all symbols.
+     */
+    [[nodiscard]] virtual std::vector<Symbols> classes(Derivatives& derivatives) const = 0;
+
+private:
+    std::size_t hash_;
 };
 
+/**
+ * @brief Rewrites a regex into an equivalent one that lowers to a smaller NFA.
+ *
+ * Nested concatenations and choices are flattened, adjacent texts merged, choices between single symbols folded into
+ * one set, nested Kleene stars collapsed and common literal prefixes factored out of choices. Nodes that cannot be
+ * simplified are returned as they are, so sub-patterns shared between regexes stay shared.
+ *
+ * @param regex The regex to simplify.
+ * @return The simplified regex.
+ */
+[[nodiscard]] std::shared_ptr<const Regex> simplify(const std::shared_ptr<const Regex>& regex);
+
 } // namespace lexer::regex
 
 #endif // LEXER_LIBS_REGEX_INCLUDE_LEXER_REGEX_REGEX_HPP
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <variant>
+#include <vector>
 
 #include "lexer/regex/regex.hpp"
 
@@ -18,28 +19,35 @@ class Repeat final : public Regex
     // Represents the Kleene star ('*') repetition, i.e. zero or more occurrences of the pattern.
     struct Kleene
     {
+        bool operator==(const Kleene&) const = default;
     };
 
     // Represents the Kleene plus ('+') repetition, i.e. one or more occurrences of the pattern.
     struct Plus
     {
+        bool operator==(const Plus&) const = default;
     };
 
     // Represents an optional pattern ('?'), i.e. zero or one occurrence.
     struct Optional
     {
+        bool operator==(const Optional&) const = default;
     };
 
     // Represents an exact repetition, i.e. exactly `count` occurrences.
     struct Exact
     {
         std::size_t count;
+
+        bool operator==(const Exact&) const = default;
     };
 
     // Represents a lower-bound repetition, i.e. at least `min` occurrences.
     struct At_least
     {
         std::size_t min;
+
+        bool operator==(const At_least&) const = default;
     };
 
     // Represents a bounded repetition, i.e. between `min` and `max` occurrences inclusive.
@@ -47,6 +55,8 @@ class Repeat final : public Regex
     {
         std::size_t min;
         std::size_t max;
+
+        bool operator==(const Range&) const = default;
     };
 
     using Variant_t = std::variant<Kleene, Plus, Optional, Exact, At_least, Range>;
@@ -104,26 +114,41 @@ public:
     Repeat(Repeat&&) = delete;
     Repeat& operator=(Repeat&&) = delete;
 
-    /**
-     * @brief Converts this regex node to an NFA builder.
-     * @return NFA builder representing this regex.
-     */
-    [[nodiscard]] nfa::Builder to_nfa() const override;
-
 private:
     Repeat(const Variant_t& variant, std::shared_ptr<const Regex> regex);
 
-    [[nodiscard]] nfa::Builder to_kleene() const;
+    [[nodiscard]] static std::size_t structural_hash(const Variant_t& variant, const Regex& regex);
+
+    [[nodiscard]] nfa::Builder lower(Cache& cache) const override;
+
+    [[nodiscard]] Positions positions(Position_automaton& automaton) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> simplified(const std::shared_ptr<const Regex>& self) const override;
+
+    [[nodiscard]] bool equals(const Regex& other) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> interned(Interner& interner,
+            const std::shared_ptr<const Regex>& self) const override;
+
+    [[nodiscard]] bool nullable(Derivatives& derivatives) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> derivative(Derivatives& derivatives,
+            const std::shared_ptr<const Regex>& self,
+            Set::Symbol_t symbol) const override;
+
+    [[nodiscard]] std::vector<Symbols> classes(Derivatives& derivatives) const override;
+
+    [[nodiscard]] nfa::Builder to_kleene(Cache& cache) const;
 
-    [[nodiscard]] nfa::Builder to_plus() const;
+    [[nodiscard]] nfa::Builder to_plus(Cache& cache) const;
 
-    [[nodiscard]] nfa::Builder to_optional() const;
+    [[nodiscard]] nfa::Builder to_optional(Cache& cache) const;
 
-    [[nodiscard]] nfa::Builder to_exact(std::size_t count) const;
+    [[nodiscard]] nfa::Builder to_exact(Cache& cache, std::size_t count) const;
 
-    [[nodiscard]] nfa::Builder to_at_least(std::size_t min) const;
+    [[nodiscard]] nfa::Builder to_at_least(Cache& cache, std::size_t min) const;
 
-    [[nodiscard]] nfa::Builder to_range(std::size_t min, std::size_t max) const;
+    [[nodiscard]] nfa::Builder to_range(Cache& cache, std::size_t min, std::size_t max) const;
 
     Variant_t variant_;
 
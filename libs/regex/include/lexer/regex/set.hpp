@@ -1,28 +1,239 @@
 #ifndef LEXER_LIBS_REGEX_INCLUDE_SET_HPP
 #define LEXER_LIBS_REGEX_INCLUDE_SET_HPP
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
-#include <unordered_set>
+#include <iterator>
 
 namespace lexer::regex
 {
+/**
+ * @brief Fixed 256-bit set of byte symbols.
+ *
+ * Stores one bit per byte value in four 64-bit words, so set operations work a word at a time and iteration visits
+ * the symbols in ascending order.
+ */
+class Symbols
+{
+public:
+    /**
+     * @brief Symbol type stored in the set.
+     */
+    using Symbol_t = std::uint8_t;
+
+    /**
+     * @brief Forward iterator over the symbols of the set, in ascending order.
+     */
+    class Iterator
+    {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = Symbol_t;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        [[nodiscard]] Symbol_t operator*() const noexcept { return static_cast<Symbol_t>(position_); }
+
+        Iterator& operator++() noexcept
+        {
+            position_ = symbols_->next(position_ + 1);
+
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            auto result{*this};
+
+            ++*this;
+
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const noexcept { return position_ == other.position_; }
+
+    private:
+        friend class Symbols;
+
+        Iterator(const Symbols* symbols, const std::size_t position) noexcept : symbols_{symbols}, position_{position}
+        {}
+
+        const Symbols* symbols_{nullptr};
+
+        std::size_t position_{capacity};
+    };
+
+    /**
+     * @brief Number of distinct symbols.
+     */
+    static constexpr std::size_t capacity{256};
+
+    /**
+     * @brief Default-constructs an empty set.
+     */
+    Symbols() = default;
+
+    /**
+     * @brief Constructs a set from an initializer list of symbols.
+     * @param symbols The symbols to include in the set.
+     */
+    Symbols(std::initializer_list<Symbol_t> symbols) noexcept;
+
+    /**
+     * @brief Constructs a set from a range of symbols.
+     * @tparam Input Input iterator type.
+     * @param first Iterator to the first symbol.
+     * @param last Iterator past the last symbol.
+     */
+    template <std::input_iterator Input>
+    Symbols(Input first, const Input last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(static_cast<Symbol_t>(*first));
+        }
+    }
+
+    /**
+     * @brief Returns an iterator to the lowest symbol of the set.
+     * @return The iterator, equal to end() if the set is empty.
+     */
+    [[nodiscard]] Iterator begin() const noexcept { return {this, next(0)}; }
+
+    /**
+     * @brief Returns the past-the-end iterator.
+     * @return The iterator.
+     */
+    [[nodiscard]] Iterator end() const noexcept { return {this, capacity}; }
+
+    /**
+     * @brief Returns the number of symbols in the set.
+     * @return The number of set bits.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Checks if the set is empty.
+     * @return True if no symbol is set.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief Checks if a symbol belongs to the set.
+     * @param symbol The symbol to check.
+     * @return True if the symbol is set.
+     */
+    [[nodiscard]] bool contains(const Symbol_t symbol) const noexcept
+    {
+        return (words_[symbol / word_bits] >> (symbol % word_bits) & 1) != 0;
+    }
+
+    /**
+     * @brief Adds a symbol to the set.
+     * @param symbol The symbol to add.
+     */
+    void insert(const Symbol_t symbol) noexcept { words_[symbol / word_bits] |= Word_t{1} << (symbol % word_bits); }
+
+    /**
+     * @brief Adds every symbol of the closed range `[first, last]` to the set.
+     * @param first The lowest symbol of the range.
+     * @param last The highest symbol of the range.
+     */
+    void insert(Symbol_t first, Symbol_t last) noexcept;
+
+    /**
+     * @brief Removes a symbol from the set.
+     * @param symbol The symbol to remove.
+     */
+    void erase(const Symbol_t symbol) noexcept { words_[symbol / word_bits] &= ~(Word_t{1} << (symbol % word_bits)); }
+
+    /**
+     * @brief Adds all symbols of another set to this set.
+     * @param other The set to add.
+     * @return Reference to this set.
+     */
+    Symbols& operator|=(const Symbols& other) noexcept;
+
+    /**
+     * @brief Keeps only the symbols also in another set.
+     * @param other The set to intersect with.
+     * @return Reference to this set.
+     */
+    Symbols& operator&=(const Symbols& other) noexcept;
+
+    /**
+     * @brief Removes all symbols of another set from this set.
+     * @param other The set to remove.
+     * @return Reference to this set.
+     */
+    Symbols& operator-=(const Symbols& other) noexcept;
+
+    /**
+     * @brief Returns the complement of the set.
+     * @return The set of all symbols not in this set.
+     */
+    [[nodiscard]] Symbols operator~() const noexcept;
+
+    /**
+     * @brief Equality comparison operator for sets.
+     * @return True if both sets contain the same symbols.
+     */
+    bool operator==(const Symbols&) const noexcept = default;
+
+    /**
+     * @brief Returns a hash of the symbols in the set.
+     * @return The hash value.
+     */
+    [[nodiscard]] std::size_t hash() const noexcept;
+
+private:
+    using Word_t = std::uint64_t;
+
+    static constexpr std::size_t word_bits{64};
+
+    /**
+     * @brief Returns the position of the lowest set bit at or after a position, or `capacity` if there is none.
+     */
+    [[nodiscard]] std::size_t next(std::size_t position) const noexcept
+    {
+        for (; position < capacity; position = (position / word_bits + 1) * word_bits)
+        {
+            if (const auto word{words_[position / word_bits] >> (position % word_bits)}; word != 0)
+            {
+                return position + static_cast<std::size_t>(std::countr_zero(word));
+            }
+        }
+
+        return capacity;
+    }
+
+    std::array<Word_t, capacity / word_bits> words_{};
+};
+
 /**
  * @brief Represents a set of characters for use in regex character classes.
  *
- * Provides methods for constructing, combining, and querying sets of characters.
+ * Provides methods for constructing, combining, and querying sets of characters. Sets are 256-bit bitsets, so
+ * combining them is word-parallel and their symbols are always enumerated in ascending order.
  */
 class Set
 {
 public:
     /**
      * @brief Symbol type used inside a character set.
+     *
+     * Symbols are unsigned bytes, covering the full 8-bit alphabet.
      */
-    using Symbol_t = char;
+    using Symbol_t = std::uint8_t;
 
     /**
      * @brief Underlying container for character symbols in a set.
      */
-    using Symbols_t = std::unordered_set<Symbol_t>;
+    using Symbols_t = Symbols;
 
     /**
      * @brief Default-constructs an empty set.
@@ -49,7 +260,7 @@ public:
 
     /**
      * @brief Returns the symbols in the set.
-     * @return Reference to the set of symbols.
+     * @return Reference to the set of symbols, iterable in ascending order.
      */
     const Symbols_t& symbols() const noexcept;
 
@@ -118,11 +329,17 @@ public:
     static Set whitespace();
 
     /**
-     * @brief Creates a set containing all possible characters.
+     * @brief Creates a set containing all possible characters, i.e. every byte value.
      * @return The created set.
      */
     static Set all();
 
+    /**
+     * @brief Returns the set of all bytes not in this set.
+     * @return The complement of this set with respect to all().
+     */
+    [[nodiscard]] Set complement() const;
+
     /**
      * @brief Adds all symbols from another set to this set.
      * @param other The set to add.
@@ -137,6 +354,13 @@ public:
      */
     Set& operator+=(Symbol_t s);
 
+    /**
+     * @brief Keeps only the symbols also contained in another set.
+     * @param other The set to intersect with.
+     * @return Reference to this set.
+     */
+    Set& operator&=(const Set& other);
+
     /**
      * @brief Removes all symbols from another set from this set.
      * @param other The set to remove.
@@ -167,6 +391,14 @@ public:
      */
     friend Set operator+(Set lhs, Symbol_t s);
 
+    /**
+     * @brief Returns the intersection of two sets.
+     * @param lhs The left-hand set.
+     * @param rhs The right-hand set.
+     * @return The intersection of the two sets.
+     */
+    friend Set operator&(Set lhs, const Set& rhs);
+
     /**
      * @brief Returns the difference of two sets.
      * @param lhs The left-hand set.
@@ -191,6 +423,12 @@ public:
      */
     friend Set operator+(Symbol_t s, Set rhs);
 
+    /**
+     * @brief Equality comparison operator for sets.
+     * @return True if both sets contain the same symbols.
+     */
+    bool operator==(const Set&) const noexcept = default;
+
 private:
     Symbols_t symbols_;
 };
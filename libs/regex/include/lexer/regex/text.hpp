@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "lexer/regex/regex.hpp"
 
@@ -28,23 +29,39 @@ public:
         return std::shared_ptr<Text>(new Text(std::forward<T>(arg)));
     }
 
+    /**
+     * @brief Returns the matched text.
+     * @return Reference to the sequence of characters to match.
+     */
+    [[nodiscard]] const std::string& text() const noexcept;
+
     Text(const Text&) = delete;
     Text& operator=(const Text&) = delete;
 
     Text(Text&&) = delete;
     Text& operator=(Text&&) = delete;
 
-    /**
-     * @brief Converts this regex node to an NFA builder.
-     * @return NFA builder representing this regex.
-     */
-    [[nodiscard]] nfa::Builder to_nfa() const override;
-
 private:
+    [[nodiscard]] nfa::Builder lower(Cache& cache) const override;
+
+    [[nodiscard]] Positions positions(Position_automaton& automaton) const override;
+
+    [[nodiscard]] bool equals(const Regex& other) const override;
+
+    [[nodiscard]] bool nullable(Derivatives& derivatives) const override;
+
+    [[nodiscard]] std::shared_ptr<const Regex> derivative(Derivatives& derivatives,
+            const std::shared_ptr<const Regex>& self,
+            Set::Symbol_t symbol) const override;
+
+    [[nodiscard]] std::vector<Symbols> classes(Derivatives& derivatives) const override;
+
     template <typename T>
-    explicit Text(T&& arg) : text_{std::forward<T>(arg)}
+    explicit Text(T&& arg) : Text{std::string{std::forward<T>(arg)}}
     {}
 
+    explicit Text(std::string text);
+
     std::string text_;
 };
 
@@ -1,30 +1,100 @@
 #include "lexer/regex/any_of.hpp"
 
-#include <algorithm>
+#include <boost/container_hash/hash.hpp>
+#include <iterator>
+#include <typeinfo>
+#include <utility>
+
+#include "lexer/regex/derivatives.hpp"
+#include "lexer/regex/position_automaton.hpp"
 
 namespace lexer::regex
 {
-nfa::Builder Any_of::to_nfa() const
+namespace
+{
+// Hashes a set node from its kind and its symbols.
+std::size_t structural_hash(const Set& set)
+{
+    auto seed{typeid(Any_of).hash_code()};
+
+    boost::hash_combine(seed, set.symbols().hash());
+
+    return seed;
+}
+
+} // namespace
+
+Any_of::Any_of(Set set) : Regex{structural_hash(set)}, set_{std::move(set)}
+{}
+
+const Set& Any_of::set() const noexcept
+{
+    return set_;
+}
+
+bool Any_of::equals(const Regex& other) const
+{
+    return set_ == static_cast<const Any_of&>(other).set_;
+}
+
+nfa::Builder Any_of::lower(Cache&) const
 {
     /**
-     * Creates a transition for all symbols in set to the same accept state.
+     * Creates a transition for each contiguous range of symbols in set to the same accept state.
      *
-     *      / --s[0]--> \
-     *     / ---s[1]---> \
-     * (q0) ---- ... ---> (q1)
-     *     \ ---s[n]---> /
+     *      / --[s0-s1]--> \
+     *     / --[s2-s3]---> \
+     * (q0) ----- ... ----> (q1)
+     *     \ --[sm-sn]---> /
      */
     nfa::Builder nfa;
 
     const auto accept_state{nfa.next_state()};
 
-    std::ranges::for_each(set_.symbols(), [&nfa, accept_state](const char symbol) {
-        nfa.add_transition(nfa.init_state(), nfa::Label{symbol}, accept_state);
-    });
+    // Symbols are enumerated in ascending order, so each run of consecutive symbols becomes one range.
+    const auto& symbols{set_.symbols()};
+
+    for (auto first{symbols.begin()}; first != symbols.end();)
+    {
+        auto last{first};
+
+        auto next{std::next(first)};
+
+        for (; next != symbols.end() && *next == *last + 1; ++next)
+        {
+            last = next;
+        }
+
+        nfa.add_transition(nfa.init_state(), nfa::Label{*first, *last}, accept_state);
+
+        first = next;
+    }
 
     nfa.add_accept_state(accept_state);
 
     return nfa;
 }
 
+Positions Any_of::positions(Position_automaton& automaton) const
+{
+    return automaton.add(set_);
+}
+
+bool Any_of::nullable(Derivatives&) const
+{
+    return false;
+}
+
+std::shared_ptr<const Regex> Any_of::derivative(Derivatives& derivatives,
+        const std::shared_ptr<const Regex>&,
+        const Set::Symbol_t symbol) const
+{
+    return set_.symbols().contains(symbol) ? derivatives.epsilon() : derivatives.empty();
+}
+
+std::vector<Symbols> Any_of::classes(Derivatives&) const
+{
+    return Derivatives::split(set_.symbols());
+}
+
 } // namespace lexer::regex
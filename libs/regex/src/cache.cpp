@@ -0,0 +1,25 @@
+#include "lexer/regex/cache.hpp"
+
+#include <utility>
+
+namespace lexer::regex
+{
+const nfa::Builder& Cache::to_nfa(const Regex& regex)
+{
+    if (const auto iterator = builders_.find(&regex); iterator != builders_.end())
+    {
+        return iterator->second;
+    }
+
+    // Lowering recurses into this cache for the sub-patterns, so the node is only inserted once it is complete.
+    auto builder{regex.lower(*this)};
+
+    return builders_.emplace(&regex, std::move(builder)).first->second;
+}
+
+std::size_t Cache::size() const noexcept
+{
+    return builders_.size();
+}
+
+} // namespace lexer::regex
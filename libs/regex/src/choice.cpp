@@ -1,10 +1,143 @@
 #include "lexer/regex/choice.hpp"
 
 #include <algorithm>
+#include <array>
+#include <boost/container_hash/hash.hpp>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/cache.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/derivatives.hpp"
+#include "lexer/regex/interner.hpp"
+#include "lexer/regex/position_automaton.hpp"
+#include "lexer/regex/text.hpp"
 
 namespace lexer::regex
 {
-nfa::Builder Choice::to_nfa() const
+namespace
+{
+// Hashes a choice from its kind and the hashes of its alternatives, in order.
+std::size_t structural_hash(const std::vector<std::shared_ptr<const Regex>>& regexes)
+{
+    auto seed{typeid(Choice).hash_code()};
+
+    std::ranges::for_each(regexes, [&seed](const auto& regex) { boost::hash_combine(seed, regex->hash()); });
+
+    return seed;
+}
+
+// Returns the set of symbols matched by an alternative matching exactly one symbol, if it is one.
+std::optional<Set> symbols(const Regex& regex)
+{
+    if (const auto* const any_of{dynamic_cast<const Any_of*>(&regex)})
+    {
+        return any_of->set();
+    }
+
+    if (const auto* const text{dynamic_cast<const Text*>(&regex)}; text != nullptr && text->text().size() == 1)
+    {
+        return Set::from(static_cast<Set::Symbol_t>(text->text().front()));
+    }
+
+    return std::nullopt;
+}
+
+// Returns the literal text an alternative starts with, empty if it does not start with one.
+std::string_view prefix(const Regex& regex)
+{
+    if (const auto* const text{dynamic_cast<const Text*>(&regex)})
+    {
+        return text->text();
+    }
+
+    if (const auto* const concat{dynamic_cast<const Concat*>(&regex)})
+    {
+        if (const auto* const text{dynamic_cast<const Text*>(concat->regexes().front().get())})
+        {
+            return text->text();
+        }
+    }
+
+    return {};
+}
+
+// Returns an alternative without the first `length` symbols of its literal prefix.
+std::shared_ptr<const Regex> strip(const Regex& regex, const std::size_t length)
+{
+    const auto rest{Text::create(std::string{prefix(regex).substr(length)})};
+
+    if (const auto* const concat{dynamic_cast<const Concat*>(&regex)})
+    {
+        auto regexes{concat->regexes()};
+
+        regexes.front() = rest;
+
+        return Concat::create(std::move(regexes));
+    }
+
+    return rest;
+}
+
+// Factors the longest literal prefix common to alternatives out of them.
+std::shared_ptr<const Regex> factor(const std::vector<std::shared_ptr<const Regex>>& alternatives)
+{
+    auto common{prefix(*alternatives.front())};
+
+    for (const auto& alternative : alternatives)
+    {
+        const auto other{prefix(*alternative)};
+
+        common = common.substr(0, static_cast<std::size_t>(std::ranges::mismatch(common, other).in1 - common.begin()));
+    }
+
+    std::vector<std::shared_ptr<const Regex>> rests;
+
+    rests.reserve(alternatives.size());
+
+    std::ranges::transform(alternatives, std::back_inserter(rests), [&common](const auto& alternative) {
+        return strip(*alternative, common.size());
+    });
+
+    return simplify(Concat::create(Text::create(std::string{common}), Choice::create(std::move(rests))));
+}
+
+} // namespace
+
+Choice::Choice(std::vector<std::shared_ptr<const Regex>> regexes)
+    : Regex{structural_hash(regexes)}, regexes_{std::move(regexes)}
+{}
+
+const std::vector<std::shared_ptr<const Regex>>& Choice::regexes() const noexcept
+{
+    return regexes_;
+}
+
+bool Choice::equals(const Regex& other) const
+{
+    return std::ranges::equal(regexes_, static_cast<const Choice&>(other).regexes_, Equal{});
+}
+
+std::shared_ptr<const Regex> Choice::interned(Interner& interner, const std::shared_ptr<const Regex>& self) const
+{
+    std::vector<std::shared_ptr<const Regex>> regexes;
+
+    regexes.reserve(regexes_.size());
+
+    std::ranges::transform(regexes_, std::back_inserter(regexes), [&interner](const auto& regex) {
+        return interner.intern(regex);
+    });
+
+    return std::ranges::equal(regexes, regexes_) ? self : Choice::create(std::move(regexes));
+}
+
+nfa::Builder Choice::lower(Cache& cache) const
 {
     /**
      * Connect all NFAs with ε transitions into a default constructed empty NFA.
@@ -15,9 +148,139 @@ nfa::Builder Choice::to_nfa() const
      */
     nfa::Builder nfa;
 
-    std::ranges::for_each(regexes_, [&nfa](const auto& regex) { nfa = nfa.merge(regex->to_nfa()); });
+    std::ranges::for_each(regexes_, [&nfa, &cache](const auto& regex) {
+        nfa = std::move(nfa).merge(cache.to_nfa(*regex));
+    });
 
     return nfa;
 }
 
+Positions Choice::positions(Position_automaton& automaton) const
+{
+    // The alternatives share no position, so their positions are simply gathered.
+    return std::ranges::fold_left(regexes_ | std::views::drop(1),
+            automaton.add(*regexes_.front()),
+            [&automaton](Positions positions, const auto& regex) {
+                return automaton.choice(std::move(positions), automaton.add(*regex));
+            });
+}
+
+std::shared_ptr<const Regex> Choice::simplified(const std::shared_ptr<const Regex>& self) const
+{
+    std::vector<std::shared_ptr<const Regex>> alternatives;
+
+    for (const auto& regex : regexes_)
+    {
+        const auto simple{simplify(regex)};
+
+        // Nested choices are already simplified, so their alternatives are spliced in as they are.
+        if (const auto* const choice{dynamic_cast<const Choice*>(simple.get())})
+        {
+            std::ranges::copy(choice->regexes_, std::back_inserter(alternatives));
+        }
+        else
+        {
+            alternatives.push_back(simple);
+        }
+    }
+
+    // Alternatives matching a single symbol are gathered into one set, and the others grouped by their first literal
+    // symbol, each set or group taking the place of its first alternative.
+    std::vector<std::vector<std::shared_ptr<const Regex>>> groups;
+
+    std::optional<std::size_t> set_group;
+
+    std::array<std::optional<std::size_t>, std::numeric_limits<Set::Symbol_t>::max() + 1> prefix_groups;
+
+    Set set;
+
+    for (const auto& alternative : alternatives)
+    {
+        std::optional<std::size_t>* group{nullptr};
+
+        if (const auto symbols{regex::symbols(*alternative)})
+        {
+            set += *symbols;
+            group = &set_group;
+        }
+        else if (const auto literal{prefix(*alternative)}; !literal.empty())
+        {
+            group = &prefix_groups[static_cast<Set::Symbol_t>(literal.front())];
+        }
+
+        if (group == nullptr)
+        {
+            groups.push_back({alternative});
+        }
+        else
+        {
+            if (!group->has_value())
+            {
+                *group = groups.size();
+                groups.emplace_back();
+            }
+
+            groups[**group].push_back(alternative);
+        }
+    }
+
+    std::vector<std::shared_ptr<const Regex>> regexes;
+
+    regexes.reserve(groups.size());
+
+    for (std::size_t index{0}; index < groups.size(); ++index)
+    {
+        const auto& group{groups[index]};
+
+        if (group.size() == 1)
+        {
+            regexes.push_back(group.front());
+        }
+        else if (index == set_group)
+        {
+            regexes.push_back(Any_of::create(set));
+        }
+        else
+        {
+            regexes.push_back(factor(group));
+        }
+    }
+
+    if (regexes.size() == 1)
+    {
+        return regexes.front();
+    }
+
+    return std::ranges::equal(regexes, regexes_) ? self : Choice::create(std::move(regexes));
+}
+
+bool Choice::nullable(Derivatives& derivatives) const
+{
+    return std::ranges::any_of(regexes_, [&derivatives](const auto& regex) { return derivatives.nullable(*regex); });
+}
+
+std::shared_ptr<const Regex> Choice::derivative(Derivatives& derivatives,
+        const std::shared_ptr<const Regex>&,
+        const Set::Symbol_t symbol) const
+{
+    std::vector<std::shared_ptr<const Regex>> regexes;
+
+    regexes.reserve(regexes_.size());
+
+    std::ranges::transform(regexes_, std::back_inserter(regexes), [&derivatives, symbol](const auto& regex) {
+        return derivatives.derive(regex, symbol);
+    });
+
+    return derivatives.choice(std::move(regexes));
+}
+
+std::vector<Symbols> Choice::classes(Derivatives& derivatives) const
+{
+    return std::ranges::fold_left(regexes_ | std::views::drop(1),
+            derivatives.classes(*regexes_.front()),
+            [&derivatives](const auto& classes, const auto& regex) {
+                return Derivatives::meet(classes, derivatives.classes(*regex));
+            });
+}
+
 } // namespace lexer::regex
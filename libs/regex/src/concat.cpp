@@ -1,23 +1,191 @@
 #include "lexer/regex/concat.hpp"
 
 #include <algorithm>
+#include <boost/container_hash/hash.hpp>
+#include <iterator>
 #include <ranges>
+#include <typeinfo>
+#include <utility>
+
+#include "lexer/regex/cache.hpp"
+#include "lexer/regex/derivatives.hpp"
+#include "lexer/regex/interner.hpp"
+#include "lexer/regex/position_automaton.hpp"
+#include "lexer/regex/text.hpp"
 
 namespace lexer::regex
 {
-nfa::Builder Concat::to_nfa() const
+namespace
+{
+// Hashes a concatenation from its kind and the hashes of its operands, in order.
+std::size_t structural_hash(const std::vector<std::shared_ptr<const Regex>>& regexes)
+{
+    auto seed{typeid(Concat).hash_code()};
+
+    std::ranges::for_each(regexes, [&seed](const auto& regex) { boost::hash_combine(seed, regex->hash()); });
+
+    return seed;
+}
+
+} // namespace
+
+Concat::Concat(std::vector<std::shared_ptr<const Regex>> regexes)
+    : Regex{structural_hash(regexes)}, regexes_{std::move(regexes)}
+{}
+
+const std::vector<std::shared_ptr<const Regex>>& Concat::regexes() const noexcept
+{
+    return regexes_;
+}
+
+bool Concat::equals(const Regex& other) const
+{
+    return std::ranges::equal(regexes_, static_cast<const Concat&>(other).regexes_, Equal{});
+}
+
+std::shared_ptr<const Regex> Concat::interned(Interner& interner, const std::shared_ptr<const Regex>& self) const
+{
+    std::vector<std::shared_ptr<const Regex>> regexes;
+
+    regexes.reserve(regexes_.size());
+
+    std::ranges::transform(regexes_, std::back_inserter(regexes), [&interner](const auto& regex) {
+        return interner.intern(regex);
+    });
+
+    return std::ranges::equal(regexes, regexes_) ? self : Concat::create(std::move(regexes));
+}
+
+nfa::Builder Concat::lower(Cache& cache) const
 {
     /**
      * Concatenate all NFAs with ε transitions in sequence.
      *
      * (q0) --ε--> (q1) --ε--> (q2) --ε--> (q3)
      */
-    nfa::Builder nfa{regexes_.front()->to_nfa()};
+    nfa::Builder nfa{cache.to_nfa(*regexes_.front())};
 
-    std::ranges::for_each(
-            regexes_ | std::views::drop(1), [&nfa](const auto& regex) { nfa = nfa.append(regex->to_nfa()); });
+    std::ranges::for_each(regexes_ | std::views::drop(1), [&nfa, &cache](const auto& regex) {
+        nfa = std::move(nfa).append(cache.to_nfa(*regex));
+    });
 
     return nfa;
 }
 
+Positions Concat::positions(Position_automaton& automaton) const
+{
+    // Each operand is followed by the next one.
+    return std::ranges::fold_left(regexes_ | std::views::drop(1),
+            automaton.add(*regexes_.front()),
+            [&automaton](Positions positions, const auto& regex) {
+                return automaton.concat(std::move(positions), automaton.add(*regex));
+            });
+}
+
+std::shared_ptr<const Regex> Concat::simplified(const std::shared_ptr<const Regex>& self) const
+{
+    std::vector<std::shared_ptr<const Regex>> regexes;
+
+    const auto push{[&regexes](const std::shared_ptr<const Regex>& regex) {
+        const auto* const text{dynamic_cast<const Text*>(regex.get())};
+
+        if (text == nullptr)
+        {
+            regexes.push_back(regex);
+            return;
+        }
+
+        // Empty texts match nothing, and adjacent texts are matched as one.
+        if (text->text().empty())
+        {
+            return;
+        }
+
+        if (const auto* const last{regexes.empty() ? nullptr : dynamic_cast<const Text*>(regexes.back().get())})
+        {
+            regexes.back() = Text::create(last->text() + text->text());
+        }
+        else
+        {
+            regexes.push_back(regex);
+        }
+    }};
+
+    for (const auto& regex : regexes_)
+    {
+        const auto simple{simplify(regex)};
+
+        // Nested concatenations are already simplified, so their operands are spliced in as they are.
+        if (const auto* const concat{dynamic_cast<const Concat*>(simple.get())})
+        {
+            std::ranges::for_each(concat->regexes_, push);
+        }
+        else
+        {
+            push(simple);
+        }
+    }
+
+    if (regexes.empty())
+    {
+        return Text::create(std::string{});
+    }
+
+    if (regexes.size() == 1)
+    {
+        return regexes.front();
+    }
+
+    return std::ranges::equal(regexes, regexes_) ? self : Concat::create(std::move(regexes));
+}
+
+bool Concat::nullable(Derivatives& derivatives) const
+{
+    return std::ranges::all_of(regexes_, [&derivatives](const auto& regex) { return derivatives.nullable(*regex); });
+}
+
+std::shared_ptr<const Regex> Concat::derivative(Derivatives& derivatives,
+        const std::shared_ptr<const Regex>&,
+        const Set::Symbol_t symbol) const
+{
+    const auto& head{regexes_.front()};
+
+    const auto tail{[this, &derivatives]() -> std::shared_ptr<const Regex> {
+        if (regexes_.size() == 1)
+        {
+            return derivatives.epsilon();
+        }
+
+        if (regexes_.size() == 2)
+        {
+            return regexes_.back();
+        }
+
+        return derivatives.intern(Concat::create(std::vector(std::next(regexes_.begin()), regexes_.end())));
+    }()};
+
+    auto derivative{derivatives.concat(derivatives.derive(head, symbol), tail)};
+
+    // A nullable head may be skipped, the symbol then starting the tail.
+    if (!derivatives.nullable(*head))
+    {
+        return derivative;
+    }
+
+    return derivatives.choice({std::move(derivative), derivatives.derive(tail, symbol)});
+}
+
+std::vector<Symbols> Concat::classes(Derivatives& derivatives) const
+{
+    // The derivative depends on the first operands up to the first one that is not nullable.
+    auto classes{derivatives.classes(*regexes_.front())};
+
+    for (auto it{regexes_.begin()}; derivatives.nullable(**it) && std::next(it) != regexes_.end(); ++it)
+    {
+        classes = Derivatives::meet(classes, derivatives.classes(**std::next(it)));
+    }
+
+    return classes;
+}
+
 } // namespace lexer::regex
@@ -0,0 +1,198 @@
+#include "lexer/regex/derivatives.hpp"
+
+#include <algorithm>
+#include <boost/container_hash/hash.hpp>
+#include <iterator>
+
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/text.hpp"
+
+namespace lexer::regex
+{
+std::size_t Derivatives::Hash::operator()(const std::pair<const Regex*, Symbol_t>& key) const noexcept
+{
+    auto seed{key.first->hash()};
+
+    boost::hash_combine(seed, key.second);
+
+    return seed;
+}
+
+Derivatives::Derivatives() : empty_{interner_.intern(any_of(Set{}))}, epsilon_{interner_.intern(text(""))}
+{}
+
+std::shared_ptr<const Regex> Derivatives::intern(const std::shared_ptr<const Regex>& regex)
+{
+    return interner_.intern(regex);
+}
+
+std::shared_ptr<const Regex> Derivatives::derive(const std::shared_ptr<const Regex>& regex, const Symbol_t symbol)
+{
+    const std::pair key{regex.get(), symbol};
+
+    if (const auto it{derivatives_.find(key)}; it != derivatives_.end())
+    {
+        return it->second;
+    }
+
+    auto derivative{regex->derivative(*this, regex, symbol)};
+
+    return derivatives_.emplace(key, std::move(derivative)).first->second;
+}
+
+bool Derivatives::nullable(const Regex& regex)
+{
+    if (const auto it{nullable_.find(&regex)}; it != nullable_.end())
+    {
+        return it->second;
+    }
+
+    const auto nullable{regex.nullable(*this)};
+
+    return nullable_.emplace(&regex, nullable).first->second;
+}
+
+const std::shared_ptr<const Regex>& Derivatives::empty() const noexcept
+{
+    return empty_;
+}
+
+const std::shared_ptr<const Regex>& Derivatives::epsilon() const noexcept
+{
+    return epsilon_;
+}
+
+std::shared_ptr<const Regex> Derivatives::concat(const std::shared_ptr<const Regex>& lhs,
+        const std::shared_ptr<const Regex>& rhs)
+{
+    // The empty set absorbs concatenations, of which the empty string is the unit.
+    if (lhs == empty_ || rhs == empty_)
+    {
+        return empty_;
+    }
+
+    if (lhs == epsilon_)
+    {
+        return rhs;
+    }
+
+    if (rhs == epsilon_)
+    {
+        return lhs;
+    }
+
+    // Concatenations are associative, so nested ones are flattened.
+    std::vector<std::shared_ptr<const Regex>> regexes;
+
+    for (const auto& regex : {lhs, rhs})
+    {
+        if (const auto* const concat{dynamic_cast<const Concat*>(regex.get())}; concat != nullptr)
+        {
+            std::ranges::copy(concat->regexes(), std::back_inserter(regexes));
+        }
+        else
+        {
+            regexes.push_back(regex);
+        }
+    }
+
+    return interner_.intern(Concat::create(std::move(regexes)));
+}
+
+std::shared_ptr<const Regex> Derivatives::choice(std::vector<std::shared_ptr<const Regex>> regexes)
+{
+    // Choices are associative, commutative and idempotent, and the empty set is their unit: alternatives are
+    // flattened, the empty set dropped and the others sorted by structural hash and deduplicated. Sorting by address
+    // would make the order of the alternatives, and so the numbering of the DFA states, vary between runs.
+    std::vector<std::shared_ptr<const Regex>> alternatives;
+
+    for (auto& regex : regexes)
+    {
+        if (const auto* const choice{dynamic_cast<const Choice*>(regex.get())}; choice != nullptr)
+        {
+            std::ranges::copy(choice->regexes(), std::back_inserter(alternatives));
+        }
+        else if (regex != empty_)
+        {
+            alternatives.push_back(std::move(regex));
+        }
+    }
+
+    std::ranges::stable_sort(alternatives, {}, &Regex::hash);
+
+    // Alternatives are canonical, so duplicates are the same node, found among the kept alternatives of equal hash.
+    // Distinct alternatives whose hashes collide keep the order in which they were derived.
+    std::vector<std::shared_ptr<const Regex>> unique;
+
+    for (auto& regex : alternatives)
+    {
+        if (const auto same_hash{std::ranges::equal_range(unique, regex->hash(), {}, &Regex::hash)};
+            std::ranges::find(same_hash, regex) == same_hash.end())
+        {
+            unique.push_back(std::move(regex));
+        }
+    }
+
+    alternatives = std::move(unique);
+
+    if (alternatives.empty())
+    {
+        return empty_;
+    }
+
+    if (alternatives.size() == 1)
+    {
+        return alternatives.front();
+    }
+
+    return interner_.intern(Choice::create(std::move(alternatives)));
+}
+
+const Derivatives::Classes_t& Derivatives::classes(const Regex& regex)
+{
+    if (const auto it{classes_.find(&regex)}; it != classes_.end())
+    {
+        return it->second;
+    }
+
+    auto classes{regex.classes(*this)};
+
+    return classes_.emplace(&regex, std::move(classes)).first->second;
+}
+
+Derivatives::Classes_t Derivatives::split(const Symbols& symbols)
+{
+    Classes_t result;
+
+    for (const auto& symbols : {symbols, ~symbols})
+    {
+        if (!symbols.empty())
+        {
+            result.push_back(symbols);
+        }
+    }
+
+    return result;
+}
+
+Derivatives::Classes_t Derivatives::meet(const Classes_t& lhs, const Classes_t& rhs)
+{
+    Classes_t result;
+
+    for (const auto& left : lhs)
+    {
+        for (const auto& right : rhs)
+        {
+            if (auto symbols{left}; !(symbols &= right).empty())
+            {
+                result.push_back(symbols);
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace lexer::regex
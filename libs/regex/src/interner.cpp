@@ -0,0 +1,21 @@
+#include "lexer/regex/interner.hpp"
+
+namespace lexer::regex
+{
+std::shared_ptr<const Regex> Interner::intern(const std::shared_ptr<const Regex>& regex)
+{
+    if (const auto iterator = nodes_.find(regex); iterator != nodes_.end())
+    {
+        return *iterator;
+    }
+
+    // The node is rebuilt over canonical operands only if some of them were interned under another node.
+    return *nodes_.insert(regex->interned(*this, regex)).first;
+}
+
+std::size_t Interner::size() const noexcept
+{
+    return nodes_.size();
+}
+
+} // namespace lexer::regex
@@ -0,0 +1,119 @@
+#include "lexer/regex/position_automaton.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace lexer::regex
+{
+Positions Position_automaton::add(const Regex& regex)
+{
+    return regex.positions(*this);
+}
+
+Positions Position_automaton::add(const Set& set)
+{
+    const auto state{builder_.next_state()};
+
+    // Positions index their labels by state, so the builder must number them sequentially after the initial state.
+    assert(state == labels_.size());
+
+    auto& labels{labels_.emplace_back()};
+
+    // Symbols are enumerated in ascending order, so each run of consecutive symbols becomes one range.
+    const auto& symbols{set.symbols()};
+
+    for (auto first{symbols.begin()}; first != symbols.end();)
+    {
+        auto last{first};
+
+        auto next{std::next(first)};
+
+        for (; next != symbols.end() && *next == *last + 1; ++next)
+        {
+            last = next;
+        }
+
+        labels.emplace_back(*first, *last);
+
+        first = next;
+    }
+
+    return {false, {state}, {state}};
+}
+
+Positions Position_automaton::concat(Positions lhs, const Positions& rhs)
+{
+    follow(lhs.last, rhs.first);
+
+    if (lhs.nullable)
+    {
+        std::ranges::copy(rhs.first, std::back_inserter(lhs.first));
+    }
+
+    if (rhs.nullable)
+    {
+        std::ranges::copy(rhs.last, std::back_inserter(lhs.last));
+    }
+    else
+    {
+        lhs.last = rhs.last;
+    }
+
+    lhs.nullable = lhs.nullable && rhs.nullable;
+
+    return lhs;
+}
+
+Positions Position_automaton::choice(Positions lhs, const Positions& rhs)
+{
+    std::ranges::copy(rhs.first, std::back_inserter(lhs.first));
+    std::ranges::copy(rhs.last, std::back_inserter(lhs.last));
+
+    lhs.nullable = lhs.nullable || rhs.nullable;
+
+    return lhs;
+}
+
+Positions Position_automaton::plus(Positions positions)
+{
+    follow(positions.last, positions.first);
+
+    return positions;
+}
+
+void Position_automaton::start(const Positions& positions)
+{
+    follow({builder_.init_state()}, positions.first);
+}
+
+void Position_automaton::accept(const Positions& positions, const std::optional<nfa::Token>& token)
+{
+    std::ranges::for_each(positions.last, [this, &token](const auto state) {
+        token ? builder_.add_accept_state(state, *token) : builder_.add_accept_state(state);
+    });
+
+    // The initial state is shared by all regexes, so it keeps the highest priority token among the nullable ones.
+    if (positions.nullable)
+    {
+        builder_.add_accept_state_by_priority(builder_.init_state(), token);
+    }
+}
+
+const nfa::Builder& Position_automaton::builder() const noexcept
+{
+    return builder_;
+}
+
+void Position_automaton::follow(const std::vector<Positions::State_t>& from, const std::vector<Positions::State_t>& to)
+{
+    std::ranges::for_each(from, [this, &to](const auto state) {
+        std::ranges::for_each(to, [this, state](const auto position) {
+            std::ranges::for_each(labels_[position], [this, state, position](const auto& label) {
+                builder_.add_transition(state, label, position);
+            });
+        });
+    });
+}
+
+} // namespace lexer::regex
@@ -0,0 +1,63 @@
+#include "lexer/regex/regex.hpp"
+
+#include <typeinfo>
+
+#include "lexer/regex/cache.hpp"
+#include "lexer/regex/position_automaton.hpp"
+
+namespace lexer::regex
+{
+Regex::Regex(const std::size_t hash) noexcept : hash_{hash}
+{}
+
+std::size_t Regex::hash() const noexcept
+{
+    return hash_;
+}
+
+bool Regex::operator==(const Regex& other) const
+{
+    // The hash rules out most unequal nodes before their operands are compared.
+    return this == &other || (hash_ == other.hash_ && typeid(*this) == typeid(other) && equals(other));
+}
+
+nfa::Builder Regex::to_nfa() const
+{
+    Cache cache;
+
+    return lower(cache);
+}
+
+nfa::Builder Regex::to_nfa(Cache& cache) const
+{
+    return cache.to_nfa(*this);
+}
+
+nfa::Builder Regex::to_position_automaton() const
+{
+    Position_automaton automaton;
+
+    const auto positions{automaton.add(*this)};
+
+    automaton.start(positions);
+    automaton.accept(positions);
+
+    return automaton.builder();
+}
+
+std::shared_ptr<const Regex> Regex::simplified(const std::shared_ptr<const Regex>& self) const
+{
+    return self;
+}
+
+std::shared_ptr<const Regex> Regex::interned(Interner&, const std::shared_ptr<const Regex>& self) const
+{
+    return self;
+}
+
+std::shared_ptr<const Regex> simplify(const std::shared_ptr<const Regex>& regex)
+{
+    return regex->simplified(regex);
+}
+
+} // namespace lexer::regex
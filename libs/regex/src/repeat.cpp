@@ -1,14 +1,51 @@
 #include "lexer/regex/repeat.hpp"
 
 #include <algorithm>
+#include <boost/container_hash/hash.hpp>
 #include <ranges>
+#include <typeinfo>
+#include <utility>
+
+#include "lexer/regex/cache.hpp"
+#include "lexer/regex/derivatives.hpp"
+#include "lexer/regex/interner.hpp"
+#include "lexer/regex/position_automaton.hpp"
 
 namespace lexer::regex
 {
 Repeat::Repeat(const Variant_t& variant, std::shared_ptr<const Regex> regex)
-    : variant_{variant}, regex_{std::move(regex)}
+    : Regex{structural_hash(variant, *regex)}, variant_{variant}, regex_{std::move(regex)}
 {}
 
+std::size_t Repeat::structural_hash(const Variant_t& variant, const Regex& regex)
+{
+    auto seed{typeid(Repeat).hash_code()};
+
+    boost::hash_combine(seed, variant.index());
+
+    std::visit(
+            [&seed]<typename T>(const T& value) {
+                if constexpr (std::is_same_v<T, Exact>)
+                {
+                    boost::hash_combine(seed, value.count);
+                }
+                else if constexpr (std::is_same_v<T, At_least>)
+                {
+                    boost::hash_combine(seed, value.min);
+                }
+                else if constexpr (std::is_same_v<T, Range>)
+                {
+                    boost::hash_combine(seed, value.min);
+                    boost::hash_combine(seed, value.max);
+                }
+            },
+            variant);
+
+    boost::hash_combine(seed, regex.hash());
+
+    return seed;
+}
+
 std::shared_ptr<Repeat> Repeat::kleene(std::shared_ptr<const Regex> regex)
 {
     return std::shared_ptr<Repeat>(new Repeat(Kleene{}, std::move(regex)));
@@ -39,39 +76,139 @@ std::shared_ptr<Repeat> Repeat::range(std::shared_ptr<const Regex> regex, const
     return std::shared_ptr<Repeat>(new Repeat(Range{min, max}, std::move(regex)));
 }
 
-nfa::Builder Repeat::to_nfa() const
+nfa::Builder Repeat::lower(Cache& cache) const
 {
     return std::visit(
-            [this]<typename T>(const T& value) {
+            [this, &cache]<typename T>(const T& value) {
                 if constexpr (std::is_same_v<T, Kleene>)
                 {
-                    return to_kleene();
+                    return to_kleene(cache);
                 }
                 else if constexpr (std::is_same_v<T, Plus>)
                 {
-                    return to_plus();
+                    return to_plus(cache);
                 }
                 else if constexpr (std::is_same_v<T, Optional>)
                 {
-                    return to_optional();
+                    return to_optional(cache);
                 }
                 else if constexpr (std::is_same_v<T, Exact>)
                 {
-                    return to_exact(value.count);
+                    return to_exact(cache, value.count);
                 }
                 else if constexpr (std::is_same_v<T, At_least>)
                 {
-                    return to_at_least(value.min);
+                    return to_at_least(cache, value.min);
                 }
                 else if constexpr (std::is_same_v<T, Range>)
                 {
-                    return to_range(value.min, value.max);
+                    return to_range(cache, value.min, value.max);
+                }
+            },
+            variant_);
+}
+
+bool Repeat::equals(const Regex& other) const
+{
+    const auto& repeat{static_cast<const Repeat&>(other)};
+
+    return variant_ == repeat.variant_ && *regex_ == *repeat.regex_;
+}
+
+std::shared_ptr<const Regex> Repeat::interned(Interner& interner, const std::shared_ptr<const Regex>& self) const
+{
+    auto regex{interner.intern(regex_)};
+
+    return regex == regex_ ? self : std::shared_ptr<Repeat>(new Repeat(variant_, std::move(regex)));
+}
+
+std::shared_ptr<const Regex> Repeat::simplified(const std::shared_ptr<const Regex>& self) const
+{
+    auto regex{simplify(regex_)};
+
+    // A Kleene star absorbs any repetition of a pattern that may itself occur zero or more times.
+    const auto* const repeat{dynamic_cast<const Repeat*>(regex.get())};
+
+    if (repeat != nullptr && std::holds_alternative<Kleene>(repeat->variant_) &&
+        (std::holds_alternative<Kleene>(variant_) || std::holds_alternative<Optional>(variant_) ||
+         std::holds_alternative<Plus>(variant_)))
+    {
+        return regex;
+    }
+
+    if (repeat != nullptr && std::holds_alternative<Kleene>(variant_) &&
+        (std::holds_alternative<Optional>(repeat->variant_) || std::holds_alternative<Plus>(repeat->variant_)))
+    {
+        return kleene(repeat->regex_);
+    }
+
+    return regex == regex_ ? self : std::shared_ptr<Repeat>(new Repeat(variant_, std::move(regex)));
+}
+
+Positions Repeat::positions(Position_automaton& automaton) const
+{
+    // Bounded repetitions add fresh positions for every occurrence, as the positions of a regex are its occurrences.
+    const auto copies{[this, &automaton](Positions positions, const std::size_t count) {
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            positions = automaton.concat(std::move(positions), automaton.add(*regex_));
+        }
+
+        return positions;
+    }};
+
+    return std::visit(
+            [this, &automaton, &copies]<typename T>(const T& value) {
+                if constexpr (std::is_same_v<T, Kleene>)
+                {
+                    auto positions{automaton.plus(automaton.add(*regex_))};
+                    positions.nullable = true;
+                    return positions;
+                }
+                else if constexpr (std::is_same_v<T, Plus>)
+                {
+                    return automaton.plus(automaton.add(*regex_));
+                }
+                else if constexpr (std::is_same_v<T, Optional>)
+                {
+                    auto positions{automaton.add(*regex_)};
+                    positions.nullable = true;
+                    return positions;
+                }
+                else if constexpr (std::is_same_v<T, Exact>)
+                {
+                    return copies(Positions{}, value.count);
+                }
+                else if constexpr (std::is_same_v<T, At_least>)
+                {
+                    if (value.min == 0)
+                    {
+                        auto positions{automaton.plus(automaton.add(*regex_))};
+                        positions.nullable = true;
+                        return positions;
+                    }
+
+                    return automaton.concat(copies(Positions{}, value.min - 1), automaton.plus(automaton.add(*regex_)));
+                }
+                else if constexpr (std::is_same_v<T, Range>)
+                {
+                    // The optional occurrences are nested from the last one, so that each only follows the previous
+                    // one: (regex (regex (regex)?)?)?.
+                    Positions optional;
+
+                    for (std::size_t i{value.min}; i < value.max; ++i)
+                    {
+                        optional = automaton.concat(automaton.add(*regex_), optional);
+                        optional.nullable = true;
+                    }
+
+                    return automaton.concat(copies(Positions{}, value.min), optional);
                 }
             },
             variant_);
 }
 
-[[nodiscard]] nfa::Builder Repeat::to_kleene() const
+[[nodiscard]] nfa::Builder Repeat::to_kleene(Cache& cache) const
 {
     /**
      * Matches zero or more occurrences of a sub-pattern.
@@ -82,7 +219,7 @@ nfa::Builder Repeat::to_nfa() const
      */
     nfa::Builder S;
 
-    S = S.merge(regex_->to_nfa());
+    S = std::move(S).merge(cache.to_nfa(*regex_));
 
     std::ranges::for_each(
             S.accept_states(), [&S](const auto& pair) { S.add_epsilon_transition(pair.first, S.init_state()); });
@@ -92,7 +229,7 @@ nfa::Builder Repeat::to_nfa() const
     return S;
 }
 
-[[nodiscard]] nfa::Builder Repeat::to_plus() const
+[[nodiscard]] nfa::Builder Repeat::to_plus(Cache& cache) const
 {
     /**
      * Matches one or more occurrences of a sub-pattern.
@@ -103,7 +240,7 @@ nfa::Builder Repeat::to_nfa() const
      */
     nfa::Builder S;
 
-    S = S.merge(regex_->to_nfa());
+    S = std::move(S).merge(cache.to_nfa(*regex_));
 
     std::ranges::for_each(
             S.accept_states(), [&S](const auto& pair) { S.add_epsilon_transition(pair.first, S.init_state()); });
@@ -111,7 +248,7 @@ nfa::Builder Repeat::to_nfa() const
     return S;
 }
 
-[[nodiscard]] nfa::Builder Repeat::to_optional() const
+[[nodiscard]] nfa::Builder Repeat::to_optional(Cache& cache) const
 {
     /**
      * Matches zero or one occurrences of a sub-pattern.
@@ -120,14 +257,14 @@ nfa::Builder Repeat::to_nfa() const
      */
     nfa::Builder S;
 
-    S = S.merge(regex_->to_nfa());
+    S = std::move(S).merge(cache.to_nfa(*regex_));
 
     S.add_accept_state(S.init_state());
 
     return S;
 }
 
-[[nodiscard]] nfa::Builder Repeat::to_exact(const std::size_t count) const
+[[nodiscard]] nfa::Builder Repeat::to_exact(Cache& cache, const std::size_t count) const
 {
     /**
      * Matches an exact number of occurrences of a sub-pattern.
@@ -138,14 +275,16 @@ nfa::Builder Repeat::to_nfa() const
 
     S.add_accept_state(S.init_state());
 
-    std::ranges::for_each(std::ranges::iota_view(static_cast<std::size_t>(0), count), [this, &S](auto) {
-        S = S.append(regex_->to_nfa());
+    const auto& R{cache.to_nfa(*regex_)};
+
+    std::ranges::for_each(std::ranges::iota_view(static_cast<std::size_t>(0), count), [&S, &R](auto) {
+        S = std::move(S).append(R);
     });
 
     return S;
 }
 
-[[nodiscard]] nfa::Builder Repeat::to_at_least(const std::size_t min) const
+[[nodiscard]] nfa::Builder Repeat::to_at_least(Cache& cache, const std::size_t min) const
 {
     /**
      * Matches a range of occurrences of a sub-pattern.
@@ -154,53 +293,59 @@ nfa::Builder Repeat::to_nfa() const
      *                /                \
      * (S) --ε--> ... ((regex n)) --ε-->
      */
+    if (min == 0)
+    {
+        return to_kleene(cache);
+    }
+
     nfa::Builder S;
 
     S.add_accept_state(S.init_state());
 
-    std::ranges::for_each(
-            std::views::iota(static_cast<std::size_t>(1), min), [this, &S](auto) { S = S.append(regex_->to_nfa()); });
+    const auto& R{cache.to_nfa(*regex_)};
 
-    auto F{regex_->to_nfa()};
+    std::ranges::for_each(std::views::iota(static_cast<std::size_t>(1), min), [&S, &R](auto) {
+        S = std::move(S).append(R);
+    });
+
+    auto F{R};
 
     std::ranges::for_each(std::views::keys(F.accept_states()), [&F](const auto state) {
         F.add_epsilon_transition(state, F.init_state());
     });
 
-    return S.append(F);
+    return std::move(S).append(F);
 }
 
-[[nodiscard]] nfa::Builder Repeat::to_range(const std::size_t min, const std::size_t max) const
+[[nodiscard]] nfa::Builder Repeat::to_range(Cache& cache, const std::size_t min, const std::size_t max) const
 {
     /**
-     * Matches a range of occurrences of a sub-pattern.
+     * Matches a range of occurrences of a sub-pattern, as a chain of optional suffixes.
+     *
+     * (S) --ε--> ... ((regex n)) --ε--> ((regex n + 1)) --ε--> ... --ε--> ((regex m))
      *
-     * (S) --ε--> ... (regex n) --ε--> ... --ε--> ((regex m))
-     *                         \          \                 /
-     *                          \          \ ------ε-----> /
-     *                           \                        /
-     *                            \ ---------ε---------> /
+     * The accept states of every copy from the n-th on stay accepting instead of being joined to those of the last copy
+     * by ε transitions, so the NFA grows linearly with m and each copy only reaches the next one.
      */
     nfa::Builder S;
 
     S.add_accept_state(S.init_state());
 
-    std::ranges::for_each(
-            std::views::iota(static_cast<std::size_t>(0), min), [this, &S](auto) { S = S.append(regex_->to_nfa()); });
-
-    nfa::Nfa::States_t pending;
+    const auto& R{cache.to_nfa(*regex_)};
 
-    std::ranges::for_each(std::views::iota(min, max), [this, &S, &pending](auto) {
-        std::ranges::copy(std::views::keys(S.accept_states()), std::inserter(pending, pending.end()));
-        S = S.append(regex_->to_nfa());
+    std::ranges::for_each(std::views::iota(static_cast<std::size_t>(0), min), [&S, &R](auto) {
+        S = std::move(S).append(R);
     });
 
-    std::ranges::for_each(pending, [&S](const auto pending_state) {
-        std::ranges::for_each(std::views::keys(S.accept_states()), [&S, pending_state](const auto accept_state) {
-            S.add_epsilon_transition(pending_state, accept_state);
-        });
+    nfa::Builder::States_t exits;
+
+    std::ranges::for_each(std::views::iota(min, max), [&S, &R, &exits](auto) {
+        std::ranges::copy(std::views::keys(S.accept_states()), std::inserter(exits, exits.end()));
+        S = std::move(S).append(R);
     });
 
+    std::ranges::for_each(exits, [&S](const auto exit) { S.add_accept_state(exit); });
+
     return S;
 }
 
@@ -234,4 +379,88 @@ std::shared_ptr<const Regex> range(std::shared_ptr<const Regex> regex, const std
     return Repeat::range(std::move(regex), min, max);
 }
 
+bool Repeat::nullable(Derivatives& derivatives) const
+{
+    return std::visit(
+            [this, &derivatives]<typename T>(const T& value) {
+                if constexpr (std::is_same_v<T, Kleene> || std::is_same_v<T, Optional>)
+                {
+                    return true;
+                }
+                else if constexpr (std::is_same_v<T, Plus>)
+                {
+                    return derivatives.nullable(*regex_);
+                }
+                else if constexpr (std::is_same_v<T, Exact>)
+                {
+                    return value.count == 0 || derivatives.nullable(*regex_);
+                }
+                else
+                {
+                    return value.min == 0 || derivatives.nullable(*regex_);
+                }
+            },
+            variant_);
+}
+
+std::shared_ptr<const Regex> Repeat::derivative(Derivatives& derivatives,
+        const std::shared_ptr<const Regex>& self,
+        const Set::Symbol_t symbol) const
+{
+    // The symbol starts one occurrence of the pattern, followed by the remaining repetitions. When the pattern is
+    // nullable, skipping occurrences only matches strings that the remaining repetitions match too.
+    const auto then{[this, &derivatives, symbol](const std::shared_ptr<const Regex>& rest) {
+        return derivatives.concat(derivatives.derive(regex_, symbol), derivatives.intern(rest));
+    }};
+
+    return std::visit(
+            [this, &derivatives, &self, &then]<typename T>(const T& value) {
+                if constexpr (std::is_same_v<T, Kleene>)
+                {
+                    return then(self);
+                }
+                else if constexpr (std::is_same_v<T, Plus>)
+                {
+                    return then(Repeat::kleene(regex_));
+                }
+                else if constexpr (std::is_same_v<T, Optional>)
+                {
+                    return then(derivatives.epsilon());
+                }
+                else if constexpr (std::is_same_v<T, Exact>)
+                {
+                    if (value.count == 0)
+                    {
+                        return derivatives.empty();
+                    }
+
+                    return then(value.count == 1 ? derivatives.epsilon() : Repeat::exact(regex_, value.count - 1));
+                }
+                else if constexpr (std::is_same_v<T, At_least>)
+                {
+                    return then(value.min <= 1 ? Repeat::kleene(regex_) : Repeat::at_least(regex_, value.min - 1));
+                }
+                else if constexpr (std::is_same_v<T, Range>)
+                {
+                    if (value.max == 0)
+                    {
+                        return derivatives.empty();
+                    }
+
+                    if (value.max == 1)
+                    {
+                        return then(derivatives.epsilon());
+                    }
+
+                    return then(Repeat::range(regex_, value.min == 0 ? 0 : value.min - 1, value.max - 1));
+                }
+            },
+            variant_);
+}
+
+std::vector<Symbols> Repeat::classes(Derivatives& derivatives) const
+{
+    return derivatives.classes(*regex_);
+}
+
 } // namespace lexer::regex
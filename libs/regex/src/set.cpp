@@ -1,10 +1,79 @@
 #include "lexer/regex/set.hpp"
 
 #include <algorithm>
-#include <ranges>
+#include <boost/container_hash/hash.hpp>
+#include <functional>
+#include <numeric>
 
 namespace lexer::regex
 {
+Symbols::Symbols(const std::initializer_list<Symbol_t> symbols) noexcept
+{
+    std::ranges::for_each(symbols, [this](const auto symbol) { insert(symbol); });
+}
+
+std::size_t Symbols::size() const noexcept
+{
+    return std::transform_reduce(words_.begin(), words_.end(), std::size_t{0}, std::plus{}, [](const auto word) {
+        return static_cast<std::size_t>(std::popcount(word));
+    });
+}
+
+bool Symbols::empty() const noexcept
+{
+    return std::ranges::all_of(words_, [](const auto word) { return word == 0; });
+}
+
+void Symbols::insert(const Symbol_t first, const Symbol_t last) noexcept
+{
+    // Set the bits [first, last] word by word: each word gets the part of the range it overlaps.
+    for (auto word{first / word_bits}; word <= last / word_bits; ++word)
+    {
+        const auto low{word == first / word_bits ? first % word_bits : 0};
+
+        const auto high{word == last / word_bits ? last % word_bits : word_bits - 1};
+
+        words_[word] |= (~Word_t{0} >> (word_bits - 1 - high)) & (~Word_t{0} << low);
+    }
+}
+
+Symbols& Symbols::operator|=(const Symbols& other) noexcept
+{
+    std::ranges::transform(words_, other.words_, words_.begin(), std::bit_or{});
+
+    return *this;
+}
+
+Symbols& Symbols::operator&=(const Symbols& other) noexcept
+{
+    std::ranges::transform(words_, other.words_, words_.begin(), std::bit_and{});
+
+    return *this;
+}
+
+Symbols& Symbols::operator-=(const Symbols& other) noexcept
+{
+    std::ranges::transform(words_, other.words_, words_.begin(), [](const auto lhs, const auto rhs) {
+        return lhs & ~rhs;
+    });
+
+    return *this;
+}
+
+Symbols Symbols::operator~() const noexcept
+{
+    Symbols result;
+
+    std::ranges::transform(words_, result.words_.begin(), std::bit_not{});
+
+    return result;
+}
+
+std::size_t Symbols::hash() const noexcept
+{
+    return boost::hash_range(words_.begin(), words_.end());
+}
+
 Set::Set(const std::initializer_list<Symbol_t> symbols) : symbols_{symbols}
 {}
 
@@ -26,16 +95,19 @@ Set Set::from(const Symbol_t s)
 
 Set Set::from(std::initializer_list<Symbol_t> symbols)
 {
-    return Set({symbols.begin(), symbols.end()});
+    return Set(symbols);
 }
 
 Set Set::range(const Symbol_t start, const Symbol_t end)
 {
-    const auto range{
-            std::views::iota(static_cast<unsigned>(start), static_cast<unsigned>(end) + 1) |
-            std::views::transform([](const auto i) { return static_cast<Symbol_t>(i); })};
+    Symbols_t symbols;
+
+    if (start <= end)
+    {
+        symbols.insert(start, end);
+    }
 
-    return Set({range.begin(), range.end()});
+    return Set(std::move(symbols));
 }
 
 Set Set::digits()
@@ -75,12 +147,17 @@ Set Set::whitespace()
 
 Set Set::all()
 {
-    return range(0, 127);
+    return range(0, 255);
+}
+
+Set Set::complement() const
+{
+    return Set(~symbols_);
 }
 
 Set& Set::operator+=(const Set& other)
 {
-    symbols_.insert(other.symbols_.begin(), other.symbols_.end());
+    symbols_ |= other.symbols_;
 
     return *this;
 }
@@ -92,9 +169,16 @@ Set& Set::operator+=(const Symbol_t s)
     return *this;
 }
 
+Set& Set::operator&=(const Set& other)
+{
+    symbols_ &= other.symbols_;
+
+    return *this;
+}
+
 Set& Set::operator-=(const Set& other)
 {
-    std::ranges::for_each(other.symbols_, [this](const Symbol_t s) { symbols_.erase(s); });
+    symbols_ -= other.symbols_;
 
     return *this;
 }
@@ -120,6 +204,13 @@ Set operator+(Set lhs, const Set::Symbol_t s)
     return lhs;
 }
 
+Set operator&(Set lhs, const Set& rhs)
+{
+    lhs &= rhs;
+
+    return lhs;
+}
+
 Set operator-(Set lhs, const Set& rhs)
 {
     lhs -= rhs;
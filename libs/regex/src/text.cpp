@@ -1,10 +1,43 @@
 #include "lexer/regex/text.hpp"
 
 #include <algorithm>
+#include <boost/container_hash/hash.hpp>
+#include <typeinfo>
+#include <utility>
+
+#include "lexer/regex/derivatives.hpp"
+#include "lexer/regex/position_automaton.hpp"
 
 namespace lexer::regex
 {
-nfa::Builder Text::to_nfa() const
+namespace
+{
+// Hashes a text node from its kind and its characters.
+std::size_t structural_hash(const std::string& text)
+{
+    auto seed{typeid(Text).hash_code()};
+
+    boost::hash_combine(seed, text);
+
+    return seed;
+}
+
+} // namespace
+
+Text::Text(std::string text) : Regex{structural_hash(text)}, text_{std::move(text)}
+{}
+
+const std::string& Text::text() const noexcept
+{
+    return text_;
+}
+
+bool Text::equals(const Regex& other) const
+{
+    return text_ == static_cast<const Text&>(other).text_;
+}
+
+nfa::Builder Text::lower(Cache&) const
 {
     /**
      * Creates a sequence of transitions for each symbol in text.
@@ -15,7 +48,7 @@ nfa::Builder Text::to_nfa() const
 
     const auto accept_state{std::ranges::fold_left(text_, nfa.init_state(), [&nfa](const auto from, const char symbol) {
         const auto to{nfa.next_state()};
-        nfa.add_transition(from, nfa::Label{symbol}, to);
+        nfa.add_transition(from, nfa::Label{static_cast<nfa::Label::Symbol_t>(symbol)}, to);
         return to;
     })};
 
@@ -24,4 +57,35 @@ nfa::Builder Text::to_nfa() const
     return nfa;
 }
 
+Positions Text::positions(Position_automaton& automaton) const
+{
+    // One position per symbol, each followed by the next one.
+    return std::ranges::fold_left(text_, Positions{}, [&automaton](Positions positions, const char symbol) {
+        return automaton.concat(std::move(positions), automaton.add(Set::from(static_cast<Set::Symbol_t>(symbol))));
+    });
+}
+
+bool Text::nullable(Derivatives&) const
+{
+    return text_.empty();
+}
+
+std::shared_ptr<const Regex> Text::derivative(Derivatives& derivatives,
+        const std::shared_ptr<const Regex>&,
+        const Set::Symbol_t symbol) const
+{
+    if (text_.empty() || static_cast<Set::Symbol_t>(text_.front()) != symbol)
+    {
+        return derivatives.empty();
+    }
+
+    return derivatives.intern(Text::create(text_.substr(1)));
+}
+
+std::vector<Symbols> Text::classes(Derivatives&) const
+{
+    // Only the first character is told apart from the others.
+    return Derivatives::split(text_.empty() ? Symbols{} : Symbols{static_cast<Set::Symbol_t>(text_.front())});
+}
+
 } // namespace lexer::regex
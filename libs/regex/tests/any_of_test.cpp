@@ -44,7 +44,7 @@ TEST_F(Any_of_test, Single_char)
 
     for (const auto set = Set::all() - single_char; auto symbol : set.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(std::nullopt, 0));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(std::nullopt, 0));
     }
 
     EXPECT_EQ(Simulator::run(nfa, "ab"), Result_t(token, 1));
@@ -72,15 +72,12 @@ TEST_F(Any_of_test, Multiple_chars)
     EXPECT_EQ(builder.accept_states().size(), 1);
     EXPECT_TRUE(builder.accept_states().contains(1));
 
-    EXPECT_EQ(builder.transitions().size(), 3);
+    // Contiguous symbols share a single range transition.
+    EXPECT_EQ(builder.transitions().size(), 1);
 
-    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('a')}));
-    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('b')}));
-    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('c')}));
+    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('a', 'c')}));
 
-    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label('a')}).size(), 1);
-    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label('b')}).size(), 1);
-    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label('c')}).size(), 1);
+    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label('a', 'c')}).size(), 1);
 }
 
 TEST_F(Any_of_test, Simulate_multiple_char)
@@ -99,12 +96,12 @@ TEST_F(Any_of_test, Simulate_multiple_char)
 
     for (const auto symbol : multiple_chars.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(token, 1));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(token, 1));
     }
 
     for (const auto set = Set::all() - multiple_chars; const auto symbol : set.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(std::nullopt, 0));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(std::nullopt, 0));
     }
 
     EXPECT_EQ(Simulator::run(nfa, "ab"), Result_t(token, 1));
@@ -132,12 +129,13 @@ TEST_F(Any_of_test, Alpha_chars)
     EXPECT_EQ(builder.accept_states().size(), 1);
     EXPECT_TRUE(builder.accept_states().contains(1));
 
-    EXPECT_EQ(builder.transitions().size(), alpha_chars.symbols().size());
+    EXPECT_EQ(builder.transitions().size(), 2);
 
-    std::ranges::for_each(alpha_chars.symbols(), [&builder](const auto symbol) {
-        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label{symbol}}));
-        EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label{symbol}}).size(), 1);
-    });
+    for (const auto& label : {nfa::Label('A', 'Z'), nfa::Label('a', 'z')})
+    {
+        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), label}));
+        EXPECT_EQ(builder.transitions().at({builder.init_state(), label}).size(), 1);
+    }
 }
 
 TEST_F(Any_of_test, Simulate_alpha_chars)
@@ -156,12 +154,12 @@ TEST_F(Any_of_test, Simulate_alpha_chars)
 
     for (const auto symbol : alpha_chars.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(token, 1));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(token, 1));
     }
 
     for (const auto set = Set::all() - alpha_chars; const auto symbol : set.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(std::nullopt, 0));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(std::nullopt, 0));
     }
 
     EXPECT_EQ(Simulator::run(nfa, "ab"), Result_t(token, 1));
@@ -189,12 +187,11 @@ TEST_F(Any_of_test, Digit_chars)
     EXPECT_EQ(builder.accept_states().size(), 1);
     EXPECT_TRUE(builder.accept_states().contains(1));
 
-    EXPECT_EQ(builder.transitions().size(), digit_chars.symbols().size());
+    EXPECT_EQ(builder.transitions().size(), 1);
 
-    std::ranges::for_each(digit_chars.symbols(), [&builder](const auto symbol) {
-        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label{symbol}}));
-        EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label{symbol}}).size(), 1);
-    });
+    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('0', '9')}));
+
+    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label('0', '9')}).size(), 1);
 }
 
 TEST_F(Any_of_test, Simulate_digit_chars)
@@ -213,12 +210,12 @@ TEST_F(Any_of_test, Simulate_digit_chars)
 
     for (const auto symbol : digit_chars.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(token, 1));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(token, 1));
     }
 
     for (const auto set = Set::all() - digit_chars; const auto symbol : set.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(std::nullopt, 0));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(std::nullopt, 0));
     }
 
     EXPECT_EQ(Simulator::run(nfa, "123"), Result_t(token, 1));
@@ -246,12 +243,13 @@ TEST_F(Any_of_test, Alphanum_chars)
     EXPECT_EQ(builder.accept_states().size(), 1);
     EXPECT_TRUE(builder.accept_states().contains(1));
 
-    EXPECT_EQ(builder.transitions().size(), alphanum_chars.symbols().size());
+    EXPECT_EQ(builder.transitions().size(), 3);
 
-    std::ranges::for_each(alphanum_chars.symbols(), [&builder](const auto symbol) {
-        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label{symbol}}));
-        EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label{symbol}}).size(), 1);
-    });
+    for (const auto& label : {nfa::Label('0', '9'), nfa::Label('A', 'Z'), nfa::Label('a', 'z')})
+    {
+        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), label}));
+        EXPECT_EQ(builder.transitions().at({builder.init_state(), label}).size(), 1);
+    }
 }
 
 TEST_F(Any_of_test, Simulate_alphanum_chars)
@@ -270,12 +268,12 @@ TEST_F(Any_of_test, Simulate_alphanum_chars)
 
     for (const auto symbol : alphanum_chars.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(token, 1));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(token, 1));
     }
 
     for (const auto set = Set::all() - alphanum_chars; const auto symbol : set.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(std::nullopt, 0));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(std::nullopt, 0));
     }
 
     EXPECT_EQ(Simulator::run(nfa, "ab"), Result_t(token, 1));
@@ -303,12 +301,11 @@ TEST_F(Any_of_test, Printable_chars)
     EXPECT_EQ(builder.accept_states().size(), 1);
     EXPECT_TRUE(builder.accept_states().contains(1));
 
-    EXPECT_EQ(builder.transitions().size(), printable_chars.symbols().size());
+    EXPECT_EQ(builder.transitions().size(), 1);
+
+    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label(' ', '~')}));
 
-    std::ranges::for_each(printable_chars.symbols(), [&builder](const auto symbol) {
-        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label{symbol}}));
-        EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label{symbol}}).size(), 1);
-    });
+    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label(' ', '~')}).size(), 1);
 }
 
 TEST_F(Any_of_test, Simulate_printable_chars)
@@ -327,12 +324,12 @@ TEST_F(Any_of_test, Simulate_printable_chars)
 
     for (const auto symbol : printable_chars.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(token, 1));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(token, 1));
     }
 
     for (const auto set = Set::all() - printable_chars; const auto symbol : set.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(std::nullopt, 0));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(std::nullopt, 0));
     }
 
     EXPECT_EQ(Simulator::run(nfa, "ab"), Result_t(token, 1));
@@ -360,12 +357,11 @@ TEST_F(Any_of_test, All_chars)
     EXPECT_EQ(builder.accept_states().size(), 1);
     EXPECT_TRUE(builder.accept_states().contains(1));
 
-    EXPECT_EQ(builder.transitions().size(), all_chars.symbols().size());
+    EXPECT_EQ(builder.transitions().size(), 1);
+
+    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('\0', '\xFF')}));
 
-    std::ranges::for_each(all_chars.symbols(), [&builder](const auto symbol) {
-        EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label{symbol}}));
-        EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label{symbol}}).size(), 1);
-    });
+    EXPECT_EQ(builder.transitions().at({builder.init_state(), nfa::Label('\0', '\xFF')}).size(), 1);
 }
 
 TEST_F(Any_of_test, Simulate_all_chars)
@@ -384,7 +380,7 @@ TEST_F(Any_of_test, Simulate_all_chars)
 
     for (const auto symbol : all_chars.symbols())
     {
-        EXPECT_EQ(Simulator::run(nfa, std::string{symbol}), Result_t(token, 1));
+        EXPECT_EQ(Simulator::run(nfa, std::string(1, static_cast<char>(symbol))), Result_t(token, 1));
     }
 
     EXPECT_EQ(Simulator::run(nfa, ""), Result_t(token, 1));
@@ -415,3 +411,27 @@ TEST_F(Any_of_test, Empty_set)
     EXPECT_EQ(Simulator::run(nfa, "ab"), Result_t(std::nullopt, 0));
     EXPECT_EQ(Simulator::run(nfa, "abc"), Result_t(std::nullopt, 0));
 }
+
+TEST_F(Any_of_test, None_of)
+{
+    const auto regex{none_of(Set::from('"'))};
+
+    const auto builder{regex->to_nfa()};
+
+    // The complement of a single symbol is the two ranges around it.
+    EXPECT_EQ(builder.transitions().size(), 2);
+
+    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('\0', '!')}));
+    EXPECT_TRUE(builder.transitions().contains({builder.init_state(), nfa::Label('#', '\xFF')}));
+
+    const Token token{7, 1};
+
+    const auto nfa{regex->to_nfa().set_accept_token(token).build()};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(nfa, std::string{"a"}), Result_t(token, 1));
+    EXPECT_EQ(Simulator::run(nfa, std::string{"\x80"}), Result_t(token, 1));
+    EXPECT_EQ(Simulator::run(nfa, std::string{"\xFF"}), Result_t(token, 1));
+    EXPECT_EQ(Simulator::run(nfa, std::string{"\""}), Result_t(std::nullopt, 0));
+}
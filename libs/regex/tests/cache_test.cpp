@@ -0,0 +1,81 @@
+#include "lexer/regex/cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+#include "lexer/nfa/simulator.hpp"
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+using namespace lexer::nfa;
+using namespace lexer::regex;
+
+using Cache_test = testing::Test;
+
+TEST_F(Cache_test, Lower_shared_nodes_once)
+{
+    const auto digit{any_of(Set::digits())};
+
+    const auto regex{concat(digit, text("."), digit, choice(digit, text("x")))};
+
+    Cache cache;
+
+    const auto& builder{cache.to_nfa(*regex)};
+
+    // The digit, the text ".", the text "x", the choice and the concatenation.
+    EXPECT_EQ(cache.size(), 5);
+
+    // Lowering again returns the cached builder.
+    EXPECT_EQ(&cache.to_nfa(*regex), &builder);
+    EXPECT_EQ(cache.size(), 5);
+
+    const Token token{1, 1};
+
+    const auto nfa{regex->to_nfa(cache).set_accept_token(token).build()};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(nfa, "1.2x"), Result_t(token, 4));
+    EXPECT_EQ(Simulator::run(nfa, "1.23"), Result_t(token, 4));
+    EXPECT_EQ(Simulator::run(nfa, "1.2"), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Cache_test, Share_between_patterns)
+{
+    const auto digits{plus(any_of(Set::digits()))};
+
+    const auto integer{concat(optional(text("-")), digits)};
+
+    const auto fraction{concat(digits, text("."), digits)};
+
+    Cache cache;
+
+    std::ignore = integer->to_nfa(cache);
+
+    const auto size{cache.size()};
+
+    std::ignore = fraction->to_nfa(cache);
+
+    // Only the text "." and the new concatenation are lowered for the second pattern.
+    EXPECT_EQ(cache.size(), size + 2);
+}
+
+TEST_F(Cache_test, Bounded_repetition)
+{
+    const auto regex{range(any_of(Set::alpha()), 1, 64)};
+
+    const Token token{1, 1};
+
+    const auto cached{regex->to_nfa().set_accept_token(token).build()};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(cached, std::string(64, 'a')), Result_t(token, 64));
+    EXPECT_EQ(Simulator::run(cached, std::string(65, 'a')), Result_t(token, 64));
+    EXPECT_EQ(Simulator::run(cached, "ab1"), Result_t(token, 2));
+    EXPECT_EQ(Simulator::run(cached, "1"), Result_t(std::nullopt, 0));
+}
@@ -0,0 +1,127 @@
+#include "lexer/regex/derivatives.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+using namespace lexer::regex;
+
+class Derivatives_test : public testing::Test
+{
+protected:
+    // Checks if a regex matches a whole input, by deriving it with respect to every symbol.
+    bool matches(const std::shared_ptr<const Regex>& regex, const std::string& input)
+    {
+        auto derivative{derivatives.intern(regex)};
+
+        for (const char symbol : input)
+        {
+            derivative = derivatives.derive(derivative, static_cast<Set::Symbol_t>(symbol));
+        }
+
+        return derivatives.nullable(*derivative);
+    }
+
+    Derivatives derivatives;
+};
+
+TEST_F(Derivatives_test, Text_and_sets)
+{
+    const auto abc{derivatives.intern(text("abc"))};
+
+    EXPECT_EQ(derivatives.derive(abc, 'a'), derivatives.intern(text("bc")));
+    EXPECT_EQ(derivatives.derive(abc, 'b'), derivatives.empty());
+    EXPECT_EQ(derivatives.derive(derivatives.intern(any_of(Set::digits())), '7'), derivatives.epsilon());
+
+    EXPECT_TRUE(matches(text(""), ""));
+    EXPECT_FALSE(matches(text("abc"), "ab"));
+}
+
+TEST_F(Derivatives_test, Similarity)
+{
+    const auto a{derivatives.intern(text("a"))};
+    const auto b{derivatives.intern(text("b"))};
+
+    EXPECT_EQ(derivatives.concat(a, derivatives.empty()), derivatives.empty());
+    EXPECT_EQ(derivatives.concat(derivatives.epsilon(), a), a);
+    EXPECT_EQ(derivatives.choice({a, derivatives.empty(), a}), a);
+    EXPECT_EQ(derivatives.choice({a, b}), derivatives.choice({b, derivatives.choice({a, b})}));
+    EXPECT_EQ(derivatives.choice({}), derivatives.empty());
+}
+
+TEST_F(Derivatives_test, Choices_sorted_by_hash)
+{
+    const auto a{derivatives.intern(text("a"))};
+    const auto b{derivatives.intern(text("b"))};
+    const auto c{derivatives.intern(kleene(text("c")))};
+
+    const auto choice{derivatives.choice({c, b, a, b})};
+
+    ASSERT_EQ(derivatives.choice({a, c, b}), choice);
+
+    const auto& alternatives{dynamic_cast<const Choice&>(*choice).regexes()};
+
+    ASSERT_EQ(alternatives.size(), 3);
+    EXPECT_TRUE(std::ranges::is_sorted(alternatives, {}, &Regex::hash));
+}
+
+TEST_F(Derivatives_test, Finitely_many_derivatives)
+{
+    const auto regex{derivatives.intern(kleene(choice(text("ab"), concat(text("a"), kleene(text("b"))))))};
+
+    // Repeated derivatives of a star reach the same canonical nodes again.
+    const auto once{derivatives.derive(regex, 'a')};
+    const auto twice{derivatives.derive(derivatives.derive(once, 'b'), 'b')};
+
+    EXPECT_EQ(derivatives.derive(twice, 'b'), twice);
+    EXPECT_EQ(derivatives.derive(twice, 'a'), once);
+}
+
+TEST_F(Derivatives_test, Repetitions)
+{
+    const auto ab{text("ab")};
+
+    EXPECT_TRUE(matches(kleene(ab), ""));
+    EXPECT_TRUE(matches(plus(ab), "abab"));
+    EXPECT_FALSE(matches(plus(ab), ""));
+    EXPECT_FALSE(matches(optional(ab), "abab"));
+    EXPECT_TRUE(matches(exact(ab, 2), "abab"));
+    EXPECT_FALSE(matches(exact(ab, 2), "ababab"));
+    EXPECT_TRUE(matches(at_least(ab, 2), "ababab"));
+    EXPECT_FALSE(matches(at_least(ab, 2), "ab"));
+    EXPECT_TRUE(matches(range(ab, 1, 3), "ababab"));
+    EXPECT_FALSE(matches(range(ab, 1, 3), "abababab"));
+    EXPECT_TRUE(matches(range(kleene(text("a")), 2, 3), ""));
+    EXPECT_TRUE(matches(concat(optional(text("-")), plus(any_of(Set::digits()))), "-42"));
+}
+
+TEST_F(Derivatives_test, Classes)
+{
+    const auto identifier{derivatives.intern(concat(any_of(Set::alpha()), kleene(any_of(Set::alphanum()))))};
+
+    // Letters and all other symbols.
+    EXPECT_EQ(derivatives.classes(*identifier).size(), 2);
+
+    const auto tail{derivatives.derive(identifier, 'a')};
+
+    // Alphanumeric symbols and all other symbols.
+    ASSERT_EQ(derivatives.classes(*tail).size(), 2);
+    EXPECT_EQ(derivatives.classes(*tail).front().size(), 62);
+
+    const auto keyword{derivatives.intern(choice(text("if"), text("in"), concat(optional(text("-")), text("x"))))};
+
+    // 'i', '-', 'x' and all other symbols.
+    EXPECT_EQ(derivatives.classes(*keyword).size(), 4);
+
+    const auto classes{Derivatives::meet(derivatives.classes(*identifier), derivatives.classes(*keyword))};
+
+    // 'i', 'x', other letters, '-' and all other symbols.
+    EXPECT_EQ(classes.size(), 5);
+}
@@ -0,0 +1,29 @@
+#ifndef LEXER_LIBS_REGEX_TESTS_EQUIVALENCE_HPP
+#define LEXER_LIBS_REGEX_TESTS_EQUIVALENCE_HPP
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <string>
+
+#include "lexer/nfa/builder.hpp"
+#include "lexer/nfa/simulator.hpp"
+
+namespace lexer::regex
+{
+// Checks that two automata, accepting the same token, match the same prefixes of each input.
+inline void expect_equivalent(nfa::Builder actual, nfa::Builder expected, std::initializer_list<std::string> inputs)
+{
+    const nfa::Token token{1, 1};
+
+    const auto actual_nfa{actual.set_accept_token(token).build()};
+    const auto expected_nfa{expected.set_accept_token(token).build()};
+
+    for (const auto& input : inputs)
+    {
+        EXPECT_EQ(nfa::Simulator::run(actual_nfa, input), nfa::Simulator::run(expected_nfa, input)) << input;
+    }
+}
+} // namespace lexer::regex
+
+#endif // LEXER_LIBS_REGEX_TESTS_EQUIVALENCE_HPP
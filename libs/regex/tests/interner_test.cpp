@@ -0,0 +1,80 @@
+#include "lexer/regex/interner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/cache.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+using namespace lexer::regex;
+
+using Interner_test = testing::Test;
+
+TEST_F(Interner_test, Structural_equality)
+{
+    const auto number{[] { return concat(optional(text("-")), plus(any_of(Set::digits()))); }};
+
+    EXPECT_EQ(*number(), *number());
+    EXPECT_EQ(number()->hash(), number()->hash());
+
+    EXPECT_EQ(*text('a'), *text("a"));
+    EXPECT_NE(*text("ab"), *text("ac"));
+    EXPECT_NE(*any_of(Set::digits()), *any_of(Set::alpha()));
+    EXPECT_NE(*concat(text("a"), text("b")), *choice(text("a"), text("b")));
+    EXPECT_NE(*concat(text("a"), text("b")), *concat(text("b"), text("a")));
+    EXPECT_NE(*range(text("a"), 1, 3), *range(text("a"), 1, 4));
+    EXPECT_NE(*kleene(text("a")), *plus(text("a")));
+}
+
+TEST_F(Interner_test, Share_equal_nodes)
+{
+    Interner interner;
+
+    const auto integer{interner.intern(concat(optional(text("-")), plus(any_of(Set::digits()))))};
+
+    // Number of nodes of the integer pattern.
+    EXPECT_EQ(interner.size(), 5);
+
+    const auto fraction{interner.intern(concat(plus(any_of(Set::digits())), text("."), plus(any_of(Set::digits()))))};
+
+    // Only the text "." and the new concatenation are new.
+    EXPECT_EQ(interner.size(), 7);
+
+    const auto& integer_operands{dynamic_cast<const Concat&>(*integer).regexes()};
+    const auto& fraction_operands{dynamic_cast<const Concat&>(*fraction).regexes()};
+
+    EXPECT_EQ(integer_operands[1], fraction_operands[0]);
+    EXPECT_EQ(fraction_operands[0], fraction_operands[2]);
+
+    EXPECT_EQ(interner.intern(concat(optional(text("-")), plus(any_of(Set::digits())))), integer);
+    EXPECT_EQ(interner.size(), 7);
+}
+
+TEST_F(Interner_test, Keep_canonical_nodes)
+{
+    Interner interner;
+
+    const auto regex{choice(text("a"), kleene(text("b")))};
+
+    EXPECT_EQ(interner.intern(regex), regex);
+    EXPECT_EQ(interner.intern(choice(text("a"), kleene(text("b")))), regex);
+}
+
+TEST_F(Interner_test, Lower_equal_nodes_once)
+{
+    Cache cache;
+
+    std::ignore = concat(text("if"), any_of(Set::digits()))->to_nfa(cache);
+
+    const auto size{cache.size()};
+
+    std::ignore = choice(text("if"), any_of(Set::digits()))->to_nfa(cache);
+
+    // The operands, built again, are found by structure; only the choice is lowered.
+    EXPECT_EQ(cache.size(), size + 1);
+}
@@ -0,0 +1,93 @@
+#include "lexer/regex/position_automaton.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "equivalence.hpp"
+#include "lexer/nfa/simulator.hpp"
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+using namespace lexer::nfa;
+using namespace lexer::regex;
+
+class Position_automaton_test : public testing::Test
+{
+protected:
+    // Checks that the position automaton of a regex is ε-free and matches like its Thompson NFA.
+    static void expect_equivalent(const std::shared_ptr<const Regex>& regex, std::initializer_list<std::string> inputs)
+    {
+        const auto nfa{regex->to_position_automaton().build()};
+
+        for (Nfa::State_t state{0}; state < nfa.size(); ++state)
+        {
+            EXPECT_TRUE(nfa.epsilon_edges(state).empty());
+        }
+
+        lexer::regex::expect_equivalent(regex->to_position_automaton(), regex->to_nfa(), inputs);
+    }
+};
+
+TEST_F(Position_automaton_test, One_state_per_position)
+{
+    EXPECT_EQ(text("abc")->to_position_automaton().build().size(), 4);
+    EXPECT_EQ(concat(any_of(Set::alpha()), kleene(any_of(Set::alphanum())))->to_position_automaton().build().size(), 3);
+    EXPECT_EQ(choice(text("if"), text("in"))->to_position_automaton().build().size(), 5);
+}
+
+TEST_F(Position_automaton_test, Text)
+{
+    expect_equivalent(text("abc"), {"abc", "abcd", "ab", "", "x"});
+    expect_equivalent(text(""), {"", "a"});
+}
+
+TEST_F(Position_automaton_test, Concat_and_choice)
+{
+    const auto digit{any_of(Set::digits())};
+
+    expect_equivalent(concat(choice(text("0x"), digit), optional(text("u"))), {"0x", "0xu", "7", "7u", "0", "u", ""});
+    expect_equivalent(choice(text("if"), text("in"), text("int"), digit), {"if", "in", "int", "i", "5", "x"});
+}
+
+TEST_F(Position_automaton_test, Repetitions)
+{
+    const auto ab{text("ab")};
+
+    expect_equivalent(kleene(ab), {"", "ab", "abab", "aba", "b"});
+    expect_equivalent(plus(ab), {"", "ab", "abab", "aba"});
+    expect_equivalent(optional(ab), {"", "ab", "abab"});
+    expect_equivalent(exact(ab, 2), {"ab", "abab", "ababab"});
+    expect_equivalent(at_least(ab, 0), {"", "ab", "ababab"});
+    expect_equivalent(at_least(ab, 2), {"ab", "abab", "ababab"});
+    expect_equivalent(range(ab, 1, 3), {"", "ab", "abab", "ababab", "abababab"});
+    expect_equivalent(range(kleene(text("a")), 2, 3), {"", "a", "aaaa", "b"});
+}
+
+TEST_F(Position_automaton_test, Nullable_tokens)
+{
+    Position_automaton automaton;
+
+    const Token low{1, 2};
+    const Token high{2, 1};
+
+    const auto a{automaton.add(*optional(text("a")))};
+    const auto b{automaton.add(*kleene(text("b")))};
+
+    automaton.start(a);
+    automaton.accept(a, low);
+    automaton.start(b);
+    automaton.accept(b, high);
+
+    const auto nfa{automaton.builder().build()};
+
+    using Result_t = Simulator::Result_t;
+
+    // The initial state accepts the empty string for the token with the highest priority.
+    EXPECT_EQ(Simulator::run(nfa, ""), Result_t(high, 0));
+    EXPECT_EQ(Simulator::run(nfa, "a"), Result_t(low, 1));
+    EXPECT_EQ(Simulator::run(nfa, "bb"), Result_t(high, 2));
+}
@@ -6,6 +6,7 @@
 
 #include "lexer/nfa/simulator.hpp"
 #include "lexer/nfa/tools/graphviz.hpp"
+#include "lexer/regex/choice.hpp"
 #include "lexer/regex/text.hpp"
 
 using namespace lexer::nfa;
@@ -186,3 +187,64 @@ TEST_F(Repeat_test, Range_repetition)
     EXPECT_EQ(Simulator::run(nfa, "b"), Result_t(std::nullopt, 0));
     EXPECT_EQ(Simulator::run(nfa, "baaa"), Result_t(std::nullopt, 0));
 }
+
+TEST_F(Repeat_test, At_least_zero)
+{
+    const auto regex{at_least(text('a'), 0)};
+
+    const Token token{7, 1};
+
+    const auto nfa{regex->to_nfa().set_accept_token(token).build()};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(nfa, ""), Result_t(token, 0));
+    EXPECT_EQ(Simulator::run(nfa, "b"), Result_t(token, 0));
+    EXPECT_EQ(Simulator::run(nfa, "aaa"), Result_t(token, 3));
+}
+
+TEST_F(Repeat_test, Range_of_choice)
+{
+    // Sub-pattern with several accept states, each of which must stay accepting.
+    const auto regex{range(choice(text("a"), text("bc")), 1, 3)};
+
+    const Token token{8, 1};
+
+    const auto nfa{regex->to_nfa().set_accept_token(token).build()};
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(nfa, "a"), Result_t(token, 1));
+    EXPECT_EQ(Simulator::run(nfa, "bc"), Result_t(token, 2));
+    EXPECT_EQ(Simulator::run(nfa, "abc"), Result_t(token, 3));
+    EXPECT_EQ(Simulator::run(nfa, "bcab"), Result_t(token, 3));
+    EXPECT_EQ(Simulator::run(nfa, "bcabca"), Result_t(token, 5));
+
+    EXPECT_EQ(Simulator::run(nfa, ""), Result_t(std::nullopt, 0));
+    EXPECT_EQ(Simulator::run(nfa, "b"), Result_t(std::nullopt, 0));
+}
+
+TEST_F(Repeat_test, Range_grows_linearly)
+{
+    const auto regex{range(text('a'), 1, 200)};
+
+    const Token token{9, 1};
+
+    const auto nfa{regex->to_nfa().set_accept_token(token).build()};
+
+    std::size_t epsilon_transitions{0};
+
+    for (Nfa::State_t state{0}; state < nfa.size(); ++state)
+    {
+        epsilon_transitions += nfa.epsilon_edges(state).size();
+    }
+
+    // Copies are only chained to the next one, never joined to the last copy.
+    EXPECT_EQ(nfa.size(), 401);
+    EXPECT_EQ(epsilon_transitions, 200);
+
+    using Result_t = Simulator::Result_t;
+
+    EXPECT_EQ(Simulator::run(nfa, std::string(150, 'a')), Result_t(token, 150));
+    EXPECT_EQ(Simulator::run(nfa, std::string(250, 'a')), Result_t(token, 200));
+}
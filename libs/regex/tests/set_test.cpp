@@ -3,6 +3,8 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <ranges>
+#include <vector>
 
 #include "lexer/nfa/tools/graphviz.hpp"
 
@@ -125,10 +127,10 @@ TEST_F(Set_test, Printable)
 TEST_F(Set_test, All)
 {
     const Set s = Set::all();
-    EXPECT_EQ(s.symbols().size(), 128);
-    for (int i = 0; i <= 127; ++i)
+    EXPECT_EQ(s.symbols().size(), 256);
+    for (int i = 0; i <= 255; ++i)
     {
-        EXPECT_TRUE(s.symbols().contains(static_cast<char>(i)));
+        EXPECT_TRUE(s.symbols().contains(static_cast<Set::Symbol_t>(i)));
     }
 }
 
@@ -263,9 +265,9 @@ TEST_F(Set_test, Operator_minus_all_elements)
 TEST_F(Set_test, Large_set)
 {
     Set s = Set::all();
-    EXPECT_EQ(s.symbols().size(), 128);
+    EXPECT_EQ(s.symbols().size(), 256);
     s -= Set::printable();
-    EXPECT_EQ(s.symbols().size(), 33); // 128 - 95 = 33
+    EXPECT_EQ(s.symbols().size(), 161); // 256 - 95 = 161
 }
 
 TEST_F(Set_test, Copy_constructor)
@@ -297,3 +299,49 @@ TEST_F(Set_test, Move_assignment)
     s2 = std::move(s1);
     EXPECT_EQ(s2.symbols().size(), 3);
 }
+
+TEST_F(Set_test, Complement)
+{
+    const auto s{Set::from('"').complement()};
+    EXPECT_EQ(s.symbols().size(), 255);
+    EXPECT_FALSE(s.symbols().contains('"'));
+    EXPECT_TRUE(s.symbols().contains(0x00));
+    EXPECT_TRUE(s.symbols().contains(0xFF));
+    EXPECT_EQ(s.complement().symbols(), Set::from('"').symbols());
+    EXPECT_EQ(Set::all().complement().symbols(), empty_set.symbols());
+}
+
+TEST_F(Set_test, Intersection)
+{
+    const auto s{Set::alphanum() & Set::range('0', 'F')};
+    EXPECT_EQ(s.symbols().size(), 16);
+    EXPECT_TRUE(s.symbols().contains('9'));
+    EXPECT_TRUE(s.symbols().contains('A'));
+    EXPECT_FALSE(s.symbols().contains(':'));
+    EXPECT_TRUE((Set::digits() & Set::alpha()).symbols().empty());
+}
+
+TEST_F(Set_test, Ascending_iteration)
+{
+    static_assert(std::ranges::forward_range<Set::Symbols_t>);
+
+    const auto s{Set::from({'z', 'a', 0xFF, '\0', '?', '@'})};
+
+    const std::vector<Set::Symbol_t> symbols(s.symbols().begin(), s.symbols().end());
+
+    EXPECT_EQ(symbols, (std::vector<Set::Symbol_t>{0x00, '?', '@', 'a', 'z', 0xFF}));
+}
+
+TEST_F(Set_test, Range_across_words)
+{
+    const auto s{Set::range(60, 200)};
+    EXPECT_EQ(s.symbols().size(), 141);
+    EXPECT_FALSE(s.symbols().contains(59));
+    EXPECT_TRUE(s.symbols().contains(63));
+    EXPECT_TRUE(s.symbols().contains(64));
+    EXPECT_TRUE(s.symbols().contains(128));
+    EXPECT_TRUE(s.symbols().contains(200));
+    EXPECT_FALSE(s.symbols().contains(201));
+    EXPECT_TRUE(Set::range('b', 'a').symbols().empty());
+    EXPECT_EQ(Set::range(0, 255).symbols().size(), 256);
+}
@@ -0,0 +1,123 @@
+#include "lexer/regex/regex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "equivalence.hpp"
+#include "lexer/regex/any_of.hpp"
+#include "lexer/regex/choice.hpp"
+#include "lexer/regex/concat.hpp"
+#include "lexer/regex/repeat.hpp"
+#include "lexer/regex/text.hpp"
+
+using namespace lexer::regex;
+
+class Simplify_test : public testing::Test
+{
+protected:
+    // Checks that a regex and its simplification match the same prefixes of each input.
+    static void expect_equivalent(const std::shared_ptr<const Regex>& regex,
+            const std::shared_ptr<const Regex>& simple,
+            std::initializer_list<std::string> inputs)
+    {
+        lexer::regex::expect_equivalent(simple->to_nfa(), regex->to_nfa(), inputs);
+    }
+};
+
+TEST_F(Simplify_test, Keep_simple_nodes)
+{
+    const auto regex{concat(text("if"), any_of(Set::digits()))};
+
+    EXPECT_EQ(simplify(regex), regex);
+}
+
+TEST_F(Simplify_test, Flatten_concat)
+{
+    const auto digit{any_of(Set::digits())};
+
+    const auto regex{concat(concat(text("a"), digit), concat(text("b"), text("c")), concat(text(""), digit))};
+
+    const auto simple{simplify(regex)};
+
+    const auto* const concat{dynamic_cast<const Concat*>(simple.get())};
+
+    ASSERT_NE(concat, nullptr);
+    ASSERT_EQ(concat->regexes().size(), 4);
+    EXPECT_EQ(concat->regexes()[1], digit);
+    EXPECT_EQ(dynamic_cast<const Text&>(*concat->regexes()[2]).text(), "bc");
+
+    expect_equivalent(regex, simple, {"a1bc2", "a1bc", "a1b2", ""});
+}
+
+TEST_F(Simplify_test, Fold_single_symbols)
+{
+    const auto regex{choice(text("+"), text("-"), choice(text("*"), any_of(Set::digits())))};
+
+    const auto simple{simplify(regex)};
+
+    const auto* const any_of{dynamic_cast<const Any_of*>(simple.get())};
+
+    ASSERT_NE(any_of, nullptr);
+    EXPECT_EQ(any_of->set().symbols().size(), 13);
+
+    expect_equivalent(regex, simple, {"+", "-", "*", "7", "/", ""});
+}
+
+TEST_F(Simplify_test, Collapse_kleene)
+{
+    const auto a{kleene(text("a"))};
+
+    EXPECT_EQ(simplify(kleene(a)), a);
+    EXPECT_EQ(simplify(optional(a)), a);
+    EXPECT_EQ(simplify(plus(a)), a);
+
+    const auto regex{kleene(optional(text("b")))};
+
+    const auto simple{simplify(regex)};
+
+    EXPECT_NE(simple, regex);
+
+    expect_equivalent(regex, simple, {"", "b", "bbb", "bbc"});
+}
+
+TEST_F(Simplify_test, Factor_prefixes)
+{
+    const auto keyword{text("else")};
+
+    const auto inline_digit{concat(text("inline"), any_of(Set::digits()))};
+
+    const auto regex{choice(text("int"), text("if"), text("in"), inline_digit, keyword)};
+
+    const auto simple{simplify(regex)};
+
+    const auto* const choice{dynamic_cast<const Choice*>(simple.get())};
+
+    ASSERT_NE(choice, nullptr);
+    ASSERT_EQ(choice->regexes().size(), 2);
+
+    const auto* const factored{dynamic_cast<const Concat*>(choice->regexes().front().get())};
+
+    ASSERT_NE(factored, nullptr);
+    EXPECT_EQ(dynamic_cast<const Text&>(*factored->regexes().front()).text(), "i");
+    EXPECT_EQ(choice->regexes().back(), keyword);
+
+    expect_equivalent(regex, simple, {"int", "if", "in", "inline1", "inline", "i", "else", "els", "ix"});
+}
+
+TEST_F(Simplify_test, Many_operators)
+{
+    const std::string operators[]{"+", "-", "+=", "-=", "++", "--", "<", "<<", "<=", "<<=", "->", "->*"};
+
+    std::vector<std::shared_ptr<const Regex>> alternatives;
+
+    for (const auto& op : operators)
+    {
+        alternatives.push_back(text(op));
+    }
+
+    const std::shared_ptr<const Regex> regex{Choice::create(std::move(alternatives))};
+
+    expect_equivalent(regex, simplify(regex), {"+", "+=", "++", "-", "-=", "--", "->", "->*", "<<=", "<<", "<=", "<a"});
+}
@@ -1,6 +1,7 @@
 #ifndef LEXER_TOOLS_TOKENIZER_INCLUDE_LEXER_TOOLS_TOKENIZER_TOKENIZER_HPP
 #define LEXER_TOOLS_TOKENIZER_INCLUDE_LEXER_TOOLS_TOKENIZER_TOKENIZER_HPP
 
+#include <cstdint>
 #include <expected>
 #include <optional>
 #include <string>
@@ -20,6 +21,25 @@ namespace lexer::tools::tokenizer
 class Tokenizer
 {
 public:
+    /**
+     * @brief Longest-match scanning strategy.
+     */
+    enum class Mode : std::uint8_t
+    {
+        /**
+         * @brief Rescan the remaining input from every token start; worst case quadratic in the input length.
+         */
+        Backtracking,
+
+        /**
+         * @brief Memoize failed scans across tokens so that tokenizing the whole input takes linear time.
+         *
+         * The memo is bounded by dfa::Memo::default_capacity bits, so it only covers a window of positions ahead of the
+         * current token on large inputs or DFAs.
+         */
+        Linear,
+    };
+
     /**
      * @brief Standard tokenizer result type.
      *
@@ -31,16 +51,20 @@ public:
     /**
      * @brief Construct a tokenizer from a lexer.
      * @param lexer Lexer used to recognize tokens.
+     * @param mode Longest-match scanning strategy.
      */
-    explicit Tokenizer(core::Lexer lexer) : lexer_{std::move(lexer)}, offset_{0} {}
+    explicit Tokenizer(core::Lexer lexer, const Mode mode = Mode::Backtracking)
+        : lexer_{std::move(lexer)}, offset_{0}, mode_{mode}
+    {}
 
     /**
      * @brief Construct a tokenizer from a lexer and an input string held in memory.
      * @param lexer Lexer used to recognize tokens.
      * @param input Input text to tokenize.
+     * @param mode Longest-match scanning strategy.
      */
-    explicit Tokenizer(core::Lexer lexer, std::string input)
-        : lexer_{std::move(lexer)}, input_{std::move(input)}, offset_{0}
+    explicit Tokenizer(core::Lexer lexer, std::string input, const Mode mode = Mode::Backtracking)
+        : lexer_{std::move(lexer)}, input_{std::move(input)}, offset_{0}, mode_{mode}
     {}
 
     /**
@@ -51,6 +75,8 @@ public:
         input_ = std::move(input);
 
         offset_ = 0;
+
+        memo_.reset();
     }
 
     /**
@@ -73,9 +99,7 @@ public:
             return std::nullopt;
         }
 
-        const auto view{std::string_view{input_}.substr(offset_)};
-
-        const auto [token, consumed]{lexer_.tokenize<T>(view)};
+        const auto [token, consumed]{scan<T>()};
 
         if (!token || consumed == 0)
         {
@@ -90,11 +114,34 @@ public:
     }
 
 private:
+    template <typename T>
+    [[nodiscard]] core::Lexer::Result_t<T> scan()
+    {
+        const auto view{std::string_view{input_}.substr(offset_)};
+
+        if (mode_ == Mode::Backtracking)
+        {
+            return lexer_.tokenize<T>(view);
+        }
+
+        if (!memo_)
+        {
+            memo_ = lexer_.memo(input_.size());
+        }
+
+        return lexer_.tokenize<T>(view.begin(), view.end(), *memo_, offset_);
+    }
+
     core::Lexer lexer_;
 
     std::string input_;
 
     std::size_t offset_;
+
+    Mode mode_;
+
+    // Failed scans of the current input. It is kept across reset(), though rescanning from the start drops its pairs.
+    std::optional<dfa::Memo> memo_;
 };
 
 } // namespace lexer::tools::tokenizer
@@ -139,6 +139,31 @@ Lexer build_lexer()
     return builder.build();
 }
 
+// Input iterator over a string that counts the symbols consumed through it.
+struct Counting_iterator
+{
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+
+    char operator*() const { return *current; }
+
+    Counting_iterator& operator++()
+    {
+        ++current;
+        ++*consumed;
+        return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    bool operator==(const Counting_iterator& other) const { return current == other.current; }
+
+    std::string::const_iterator current;
+
+    std::size_t* consumed;
+};
+
 } // namespace
 
 TEST_F(Tokenizer_test, Tokenize_from_string_stream)
@@ -219,3 +244,98 @@ TEST_F(Tokenizer_test, Unknown_character)
     EXPECT_EQ(error.position(), 0u);
     EXPECT_FALSE(error.message().empty());
 }
+
+TEST_F(Tokenizer_test, Linear_mode_matches_backtracking)
+{
+    const std::string input{
+            "boolean x 1234 \"hello\" 3.14 // comment\n"
+            "string y 5.0e+1 /* block */ \"unterminated 42 /* open"};
+
+    const auto lexer{build_lexer()};
+
+    Tokenizer backtracking{lexer, input};
+
+    Tokenizer linear{lexer, input, Tokenizer::Mode::Linear};
+
+    for (auto pass{0}; pass < 2; ++pass)
+    {
+        for (;;)
+        {
+            const auto expected{backtracking.next<Token_kind>()};
+            const auto actual{linear.next<Token_kind>()};
+
+            ASSERT_EQ(expected.has_value(), actual.has_value());
+
+            if (!expected.has_value())
+            {
+                EXPECT_EQ(expected.error().position(), actual.error().position());
+                break;
+            }
+
+            ASSERT_EQ(expected->has_value(), actual->has_value());
+
+            if (!expected->has_value())
+            {
+                break;
+            }
+
+            EXPECT_EQ((*expected)->kind(), (*actual)->kind());
+            EXPECT_EQ((*expected)->lexeme(), (*actual)->lexeme());
+        }
+
+        backtracking.reset();
+        linear.reset();
+    }
+}
+
+TEST_F(Tokenizer_test, Linear_mode_rescan)
+{
+    enum class Kind : uint8_t
+    {
+        Run,
+        Letter,
+    };
+
+    // Every position starts a scan for the 'b' terminating a run of 'a's, which never appears.
+    Builder builder;
+
+    builder.add_token(concat(kleene(text("a")), text("b")), Kind::Run, 0);
+    builder.add_token(text("a"), Kind::Letter, 1);
+
+    const std::string input(1000, 'a');
+
+    const auto lexer{builder.build()};
+
+    Tokenizer tokenizer{lexer, input, Tokenizer::Mode::Linear};
+
+    for (std::size_t i{0}; i < input.size(); ++i)
+    {
+        const auto expected{tokenizer.next<Kind>()};
+        ASSERT_TRUE(expected.has_value());
+        ASSERT_TRUE(expected->has_value());
+        EXPECT_EQ((*expected)->kind(), Kind::Letter);
+    }
+
+    // Without the memo, the scans would consume about half the square of the input length.
+    std::size_t consumed{0};
+
+    auto memo{lexer.memo(input.size())};
+
+    for (std::size_t position{0}; position < input.size(); ++position)
+    {
+        const Counting_iterator begin{input.begin() + static_cast<std::ptrdiff_t>(position), &consumed};
+        const Counting_iterator end{input.end(), &consumed};
+
+        EXPECT_EQ(lexer.tokenize<Kind>(begin, end, memo, position), Lexer::Result_t<Kind>(Kind::Letter, 1));
+    }
+
+    EXPECT_LE(consumed, 3 * input.size());
+
+    tokenizer.load("aab");
+
+    const auto expected{tokenizer.next<Kind>()};
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_TRUE(expected->has_value());
+    EXPECT_EQ((*expected)->kind(), Kind::Run);
+    EXPECT_EQ((*expected)->lexeme(), "aab");
+}